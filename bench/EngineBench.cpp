@@ -0,0 +1,201 @@
+// Benchmarks des chemins critiques du moteur (Qt Test / QBENCHMARK)
+//
+// Résultats exploitables par machine :
+//   tank_bench -o resultats.csv,csv
+//   tank_bench -o resultats.xml,xml
+// Options utiles : -iterations N, -tickcounter, -minimumvalue N
+
+#include <QtTest>
+#include <QLoggingCategory>
+#include "../include/GameEngine.hpp"
+#include "../include/Constants.hpp"
+
+class EngineBench : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void isValidMove_data();
+    void isValidMove();
+    void checkBulletCollisions_data();
+    void checkBulletCollisions();
+    void cleanupInactive_data();
+    void cleanupInactive();
+    void createLevel();
+    void enemyUpdate_data();
+    void enemyUpdate();
+
+private:
+    // Niveau prêt à simuler, sans démarrer le FrameScheduler
+    void prepareLevel(GameEngine& engine, int enemies);
+    void addBullets(GameEngine& engine, int count, bool active);
+    bool isOpen(const GameEngine& engine, const FixedRect& box) const;
+};
+
+void EngineBench::initTestCase() {
+    // Les traces de debug du moteur fausseraient les mesures
+    QLoggingCategory::setFilterRules("*.debug=false");
+}
+
+void EngineBench::prepareLevel(GameEngine& engine, int enemies) {
+    engine.startHeadless();
+
+    for (int i = 0; i < enemies; i++) {
+        const int cell = i % (GameConstants::GRID_WIDTH * GameConstants::GRID_HEIGHT);
+        const FixedPoint position = FixedPoint::fromPixels((cell % GameConstants::GRID_WIDTH) * GameConstants::CELL_SIZE + 2,
+                                                           (cell / GameConstants::GRID_WIDTH) * GameConstants::CELL_SIZE + 2);
+        engine.addEnemy(std::make_unique<Enemy>(position));
+    }
+}
+
+bool EngineBench::isOpen(const GameEngine& engine, const FixedRect& box) const {
+    for (const auto& block : engine.getBlocks()) {
+        if (box.intersects(block->getBox())) return false;
+    }
+    if (box.intersects(engine.getPlayer()->getBox())) return false;
+    for (const auto& enemy : engine.getEnemies()) {
+        if (box.intersects(enemy->getBox())) return false;
+    }
+    return true;
+}
+
+void EngineBench::addBullets(GameEngine& engine, int count, bool active) {
+    // Balles posées sur une grille, hors de tout obstacle : aucune ne touche,
+    // chaque tick paie donc le parcours complet des collisions
+    constexpr int spacing = 12;
+    int added = 0;
+    for (int y = spacing; y < GameConstants::GAME_AREA_HEIGHT - spacing && added < count; y += spacing) {
+        for (int x = spacing; x < GameConstants::GAME_AREA_WIDTH - spacing && added < count; x += spacing) {
+            auto bullet = std::make_unique<Bullet>(FixedPoint::fromPixels(x, y), Direction::UP, added % 2 == 0);
+            if (!isOpen(engine, bullet->getBox())) continue;
+            bullet->setActive(active);
+            engine.addBullet(std::move(bullet));
+            added++;
+        }
+    }
+}
+
+void EngineBench::isValidMove_data() {
+    QTest::addColumn<int>("enemies");
+    QTest::newRow("enemies=3") << 3;
+    QTest::newRow("enemies=50") << 50;
+    QTest::newRow("enemies=200") << 200;
+}
+
+void EngineBench::isValidMove() {
+    QFETCH(int, enemies);
+    GameEngine engine;
+    prepareLevel(engine, enemies);
+
+    // Un déplacement par case de la grille, comme le ferait un tank
+    std::vector<FixedRect> rects;
+    for (int y = 0; y < GameConstants::GRID_HEIGHT; y++) {
+        for (int x = 0; x < GameConstants::GRID_WIDTH; x++) {
+            rects.push_back(FixedRect::fromPixels(x * GameConstants::CELL_SIZE + 1, y * GameConstants::CELL_SIZE + 1, 28, 28));
+        }
+    }
+
+    int valid = 0;
+    QBENCHMARK {
+        for (const FixedRect& rect : rects) {
+            valid += engine.isValidMove(rect) ? 1 : 0;
+        }
+    }
+    QVERIFY(valid >= 0);
+}
+
+void EngineBench::checkBulletCollisions_data() {
+    QTest::addColumn<int>("bullets");
+    QTest::addColumn<int>("enemies");
+    QTest::newRow("bullets=10") << 10 << 3;
+    QTest::newRow("bullets=100") << 100 << 3;
+    QTest::newRow("bullets=1000") << 1000 << 3;
+    QTest::newRow("bullets=1000,enemies=50") << 1000 << 50;
+}
+
+void EngineBench::checkBulletCollisions() {
+    QFETCH(int, bullets);
+    QFETCH(int, enemies);
+    GameEngine engine;
+    prepareLevel(engine, enemies);
+    addBullets(engine, bullets, true);
+    const size_t placed = engine.getBullets().size();
+
+    QBENCHMARK {
+        engine.checkBulletCollisions();
+    }
+
+    // Aucun impact : la charge est restée identique d'une itération à l'autre
+    int active = 0;
+    for (const auto& bullet : engine.getBullets()) {
+        active += bullet->isActive() ? 1 : 0;
+    }
+    QCOMPARE(static_cast<size_t>(active), placed);
+}
+
+void EngineBench::cleanupInactive_data() {
+    QTest::addColumn<int>("entities");
+    QTest::addColumn<bool>("removeHalf");
+    QTest::newRow("entities=100,scan") << 100 << false;
+    QTest::newRow("entities=1000,scan") << 1000 << false;
+    QTest::newRow("entities=100,remove") << 100 << true;
+    QTest::newRow("entities=1000,remove") << 1000 << true;
+}
+
+void EngineBench::cleanupInactive() {
+    QFETCH(int, entities);
+    QFETCH(bool, removeHalf);
+    GameEngine engine;
+    prepareLevel(engine, 0);
+
+    if (!removeHalf) {
+        // Rien à retirer : coût du seul parcours
+        addBullets(engine, entities, true);
+        QBENCHMARK {
+            engine.cleanupInactive();
+        }
+        return;
+    }
+
+    // Retrait de la moitié des balles ; la création des balles est incluse
+    QBENCHMARK {
+        addBullets(engine, entities / 2, true);
+        addBullets(engine, entities / 2, false);
+        engine.cleanupInactive();
+        engine.clearBullets();
+    }
+}
+
+void EngineBench::createLevel() {
+    GameEngine engine;
+    prepareLevel(engine, 0);
+
+    QBENCHMARK {
+        engine.clearBlocks();
+        engine.createLevel();
+    }
+    QVERIFY(!engine.getBlocks().empty());
+}
+
+void EngineBench::enemyUpdate_data() {
+    QTest::addColumn<int>("enemies");
+    QTest::newRow("enemies=10") << 10;
+    QTest::newRow("enemies=100") << 100;
+    QTest::newRow("enemies=1000") << 1000;
+}
+
+void EngineBench::enemyUpdate() {
+    QFETCH(int, enemies);
+    GameEngine engine;
+    prepareLevel(engine, enemies);
+
+    QBENCHMARK {
+        for (const auto& enemy : engine.getEnemies()) {
+            enemy->update();
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(EngineBench)
+#include "EngineBench.moc"
@@ -0,0 +1,168 @@
+// Benchmark du rendu de GameWidget dans une QImage hors écran
+//
+// Fonctionne sans affichage (plateforme Qt « offscreen » par défaut) :
+//   tank_render_bench -o resultats.csv,csv
+// renderScene : ms par frame ; fillRate : octets ARGB32 écrits par seconde
+// (pixels remplis × 4), avec le débit en pixels/s dans la sortie texte.
+
+#include <QtTest>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QLoggingCategory>
+#include "../include/GameWidget.hpp"
+#include "../include/Constants.hpp"
+
+enum class Scene {
+    EMPTY_MAP,
+    DENSE_BRICKS,
+    TANKS_100,
+    BULLETS_1000,
+    PAUSE_OVERLAY
+};
+Q_DECLARE_METATYPE(Scene)
+
+class RenderBench : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void renderScene_data();
+    void renderScene();
+    void fillRate_data();
+    void fillRate();
+
+private:
+    void addRows();
+    void prepareScene(GameEngine& engine, Scene scene);
+
+    static constexpr int FILL_RATE_FRAMES = 120;
+};
+
+void RenderBench::initTestCase() {
+    QLoggingCategory::setFilterRules("*.debug=false");
+}
+
+void RenderBench::addRows() {
+    QTest::addColumn<Scene>("scene");
+    QTest::addColumn<bool>("software");
+
+    const struct { const char* name; Scene scene; } scenes[] = {
+        {"empty_map", Scene::EMPTY_MAP},
+        {"dense_bricks", Scene::DENSE_BRICKS},
+        {"tanks_100", Scene::TANKS_100},
+        {"bullets_1000", Scene::BULLETS_1000},
+        {"pause_overlay", Scene::PAUSE_OVERLAY}
+    };
+
+    for (const auto& entry : scenes) {
+        QTest::newRow(QByteArray(entry.name).append(",qpainter").constData()) << entry.scene << false;
+        QTest::newRow(QByteArray(entry.name).append(",software").constData()) << entry.scene << true;
+    }
+}
+
+void RenderBench::prepareScene(GameEngine& engine, Scene scene) {
+    engine.startHeadless();
+
+    const int cells = GameConstants::GRID_WIDTH * GameConstants::GRID_HEIGHT;
+    auto cellPosition = [](int cell) {
+        return FixedPoint::fromPixels((cell % GameConstants::GRID_WIDTH) * GameConstants::CELL_SIZE,
+                                      (cell / GameConstants::GRID_WIDTH) * GameConstants::CELL_SIZE);
+    };
+
+    switch (scene) {
+        case Scene::EMPTY_MAP:
+            engine.clearBlocks();
+            break;
+
+        case Scene::DENSE_BRICKS:
+            engine.clearBlocks();
+            for (int cell = 0; cell < cells; cell++) {
+                engine.addBlock(std::make_unique<Block>(cellPosition(cell), BlockType::BRICK));
+            }
+            break;
+
+        case Scene::TANKS_100:
+            for (int i = 0; i < 100; i++) {
+                engine.addEnemy(std::make_unique<Enemy>(cellPosition(i * 6 % cells) + FixedPoint::fromPixels(2, 2)));
+            }
+            break;
+
+        case Scene::BULLETS_1000:
+            for (int i = 0; i < 1000; i++) {
+                const FixedPoint position = FixedPoint::fromPixels((i % 40) * 20 + 10, (i / 40) * 32 + 12);
+                engine.addBullet(std::make_unique<Bullet>(position, Direction::UP, i % 2 == 0));
+            }
+            break;
+
+        case Scene::PAUSE_OVERLAY:
+            engine.pauseGame();
+            break;
+    }
+}
+
+void RenderBench::renderScene_data() {
+    addRows();
+}
+
+void RenderBench::renderScene() {
+    QFETCH(Scene, scene);
+    QFETCH(bool, software);
+
+    GameEngine engine;
+    prepareScene(engine, scene);
+    GameWidget widget(&engine);
+    widget.setSoftwareRendering(software);
+
+    QImage image(widget.size(), QImage::Format_ARGB32_Premultiplied);
+
+    // Repaint complet de la zone de jeu à chaque itération
+    QBENCHMARK {
+        widget.render(&image);
+    }
+}
+
+void RenderBench::fillRate_data() {
+    addRows();
+}
+
+void RenderBench::fillRate() {
+    QFETCH(Scene, scene);
+    QFETCH(bool, software);
+
+    GameEngine engine;
+    prepareScene(engine, scene);
+    GameWidget widget(&engine);
+    widget.setSoftwareRendering(software);
+
+    QImage image(widget.size(), QImage::Format_ARGB32_Premultiplied);
+    widget.render(&image);  // Préchauffage (caches de sprites, polices)
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < FILL_RATE_FRAMES; frame++) {
+        widget.render(&image);
+    }
+    const qreal seconds = timer.nsecsElapsed() / 1.0e9;
+
+    const qreal pixels = static_cast<qreal>(image.width()) * image.height() * FILL_RATE_FRAMES;
+    const qreal pixelsPerSecond = pixels / seconds;
+    qInfo().nospace() << QTest::currentDataTag() << " ms_per_frame=" << seconds * 1000.0 / FILL_RATE_FRAMES
+                      << " pixels_per_second=" << pixelsPerSecond;
+
+    QTest::setBenchmarkResult(pixelsPerSecond * 4, QTest::BytesPerSecond);
+}
+
+int main(int argc, char* argv[]) {
+    // Aucune fenêtre n'est affichée : utilisable sur les machines d'intégration sans écran
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    RenderBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "RenderBench.moc"
@@ -0,0 +1,94 @@
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <QIODevice>
+#include <QAudioFormat>
+#include <QThread>
+#include <QString>
+#include <array>
+#include <atomic>
+#include <vector>
+
+class QAudioSink;
+
+// Mixeur logiciel : les sons sont décodés une fois en PCM mono flottant à la
+// fréquence de sortie, puis mixés dans un pool fixe de voix par un thread
+// dédié qui alimente une seule sortie QAudioSink à petit tampon.
+// play() ne fait que pousser une commande dans une file sans verrou : le son
+// démarre à la prochaine période lue par la sortie (quelques ms).
+class AudioMixer : public QIODevice {
+    Q_OBJECT
+
+public:
+    AudioMixer();
+    ~AudioMixer() override;
+
+    static constexpr int VOICE_COUNT = 16;
+    static constexpr int PERIOD_FRAMES = 256;          // ~5 ms à 48 kHz
+    static constexpr int BUFFER_PERIODS = 2;           // Tampon de la sortie
+    static constexpr int COMMAND_QUEUE_SIZE = 64;      // Puissance de 2
+
+    // Charger avant start() ; renvoie l'identifiant du son ou -1
+    int loadWav(const QString& path);
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_sink != nullptr; }
+
+    // Depuis le thread principal uniquement (file à un seul producteur).
+    // pan : -1 gauche, 0 centre, 1 droite. Une priorité plus haute peut
+    // voler la voix d'un son moins important quand le pool est plein.
+    void play(int soundId, float gain, float pan, int priority);
+    void setMasterGain(float gain) { m_masterGain.store(gain, std::memory_order_relaxed); }
+
+    int sampleRate() const { return m_format.sampleRate(); }
+
+    // WAV PCM 8/16/24 bits ou flottant 32 bits, mixé en mono puis
+    // rééchantillonné linéairement à targetRate
+    static bool decodeWav(const QByteArray& data, int targetRate, std::vector<float>& samples,
+                          QString* error = nullptr);
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    struct PlayCommand {
+        int soundId;
+        float gain;
+        float pan;
+        int priority;
+    };
+
+    struct Voice {
+        const std::vector<float>* samples = nullptr;   // nullptr = voix libre
+        size_t position = 0;
+        float gainLeft = 0.0f;
+        float gainRight = 0.0f;
+        int priority = 0;
+    };
+
+    void drainCommands();
+    void startVoice(const PlayCommand& command);
+    void mix(qint16* out, int frames);
+
+    QAudioFormat m_format;
+    QThread m_thread;
+    QAudioSink* m_sink;
+
+    std::vector<std::vector<float>> m_sounds;   // Figés après start()
+    std::array<Voice, VOICE_COUNT> m_voices;
+    std::array<float, PERIOD_FRAMES * 2> m_accumulator;
+
+    std::array<PlayCommand, COMMAND_QUEUE_SIZE> m_commands;
+    std::atomic<quint32> m_commandHead;   // Écrit par le thread principal
+    std::atomic<quint32> m_commandTail;   // Écrit par le thread du mixeur
+    std::atomic<float> m_masterGain;
+    quint64 m_droppedCommands;
+    quint64 m_stolenVoices;
+};
+
+#endif // AUDIOMIXER_H
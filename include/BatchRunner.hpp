@@ -0,0 +1,67 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <QCoreApplication>
+#include <vector>
+#include "GameEngine.hpp"
+#include "Constants.hpp"
+
+// Paramètres d'une série de parties simulées
+struct BatchConfig {
+    int matches = 1000;
+    int maxTicks = 5 * 60 * GameConstants::SIMULATION_RATE;   // 5 minutes de jeu
+    quint32 seed = 1;
+    int threads = 0;            // 0 = tous les cœurs
+    GameTuning tuning;
+};
+
+enum class MatchOutcome {
+    WIN,        // Niveau terminé
+    LOSS,       // Joueur ou base détruits
+    TIMEOUT     // maxTicks atteint
+};
+
+struct MatchResult {
+    MatchOutcome outcome;
+    int ticks;
+    int score;
+};
+
+// Agrégat d'un groupe de parties ; les agrégats partiels des threads sont
+// fusionnés par la réduction de QtConcurrent
+struct BatchReport {
+    int matches = 0;
+    int wins = 0;
+    int losses = 0;
+    int timeouts = 0;
+    qint64 ticks = 0;
+    std::vector<int> scores;
+    std::vector<int> durations;   // En ticks
+    qint64 elapsedNs = 0;         // Temps réel de toute la série
+
+    void add(const MatchResult& result);
+    void merge(const BatchReport& other);
+};
+
+// Mode --batch : des milliers de parties indépendantes, sans interface,
+// réparties sur un pool de threads. Chaque partie a son moteur, sa graine
+// et un BotPlayer ; une même graine rejoue exactement la même partie.
+class BatchRunner {
+public:
+    explicit BatchRunner(const BatchConfig& config);
+
+    BatchReport run();
+
+    static MatchResult playMatch(quint32 seed, const BatchConfig& config);
+    static quint32 matchSeed(quint32 batchSeed, int match);
+
+    // Point d'entrée de la ligne de commande : analyse, exécution, rapport
+    static int runFromCommandLine(const QCoreApplication& app);
+
+    static constexpr int MATCHES_PER_TASK = 16;   // Parties par tâche du pool
+
+private:
+    BatchConfig m_config;
+};
+
+#endif // BATCHRUNNER_H
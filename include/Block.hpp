@@ -11,16 +11,14 @@ enum class BlockType {
     BASE        // Player base to protect
 };
 
-class Block : public Entity {
+class Block final : public Entity {
 public:
-    Block(const QPointF& position, BlockType blockType);
+    Block(const FixedPoint& position, BlockType blockType);
     
     void render(QPainter& painter) override;
     
     BlockType getBlockType() const { return m_blockType; }
-    bool isDestructible() const;
-    bool blocksMovement() const;
-    bool isCamouflage() const;
+    bool isDestructible() const { return m_blockType == BlockType::BRICK; }
     
 private:
     BlockType m_blockType;
@@ -0,0 +1,35 @@
+#ifndef BOTPLAYER_H
+#define BOTPLAYER_H
+
+#include <QRandomGenerator>
+#include "GameEngine.hpp"
+
+// Joueur scripté pour les simulations en lot : s'aligne sur l'ennemi le plus
+// proche, tire quand il est dans l'axe et erre au hasard quand il est bloqué.
+// Il passe par la file d'entrées du moteur, comme le clavier.
+class BotPlayer {
+public:
+    explicit BotPlayer(quint32 seed, quint8 player = 0);   // 1 = tank partenaire
+
+    // À appeler avant chaque GameEngine::update()
+    void think(GameEngine& engine);
+
+    static constexpr qint32 ALIGN_TOLERANCE = Fixed::fromPixels(10);
+    static constexpr int STUCK_TICKS = 12;
+    static constexpr int WANDER_TICKS = 30;
+
+private:
+    void steer(GameEngine& engine, Direction direction);
+    void submit(GameEngine& engine, InputAction action, bool pressed);
+    Direction randomDirection();
+
+    QRandomGenerator m_random;
+    quint8 m_player;
+    Direction m_heading;
+    bool m_moving;
+    FixedPoint m_lastPosition;
+    int m_stuckTicks;
+    int m_wanderTicks;
+};
+
+#endif // BOTPLAYER_H
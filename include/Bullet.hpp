@@ -3,9 +3,9 @@
 
 #include "Entity.hpp"
 
-class Bullet : public Entity {
+class Bullet final : public Entity {
 public:
-    Bullet(const QPointF& position, Direction direction, bool fromPlayer);
+    Bullet(const FixedPoint& position, Direction direction, bool fromPlayer);
 
     void update() override;
     void render(QPainter& painter) override;
@@ -15,7 +15,7 @@ public:
 
 private:
     Direction m_direction;
-    int m_speed;
+    qint32 m_speed;             // Unités fixes par tick
     bool m_fromPlayer;
 
     static constexpr int BULLET_SIZE = 8;
@@ -0,0 +1,88 @@
+#ifndef COLLISIONLAYERS_H
+#define COLLISIONLAYERS_H
+
+#include <QtGlobal>
+#include "Entity.hpp"
+
+// Couches de collision. Chaque entité appartient à une couche ; une table
+// constante donne, pour chaque couche, celles avec lesquelles un contact a
+// un effet. La phase large écarte les paires absentes de la table avant
+// tout test géométrique : un nouveau type d'entité n'ajoute que les paires
+// déclarées ici.
+namespace CollisionLayers {
+
+enum Layer : int {
+    PLAYER_TANK,
+    ENEMY_TANK,
+    PLAYER_BULLET,
+    ENEMY_BULLET,
+    BRICK,
+    STEEL,
+    WATER,
+    TREE,
+    BASE,
+    POWERUP,
+    LAYER_COUNT
+};
+
+using Mask = quint16;
+static_assert(LAYER_COUNT <= 16, "Mask trop étroit pour toutes les couches");
+
+constexpr Mask bit(Layer layer) { return static_cast<Mask>(1u << layer); }
+
+// Les balles se distinguent par leur tireur, pas par leur EntityType
+constexpr Layer layerOf(EntityType type, bool fromPlayer = false) {
+    switch (type) {
+    case EntityType::PLAYER_TANK: return PLAYER_TANK;
+    case EntityType::ENEMY_TANK: return ENEMY_TANK;
+    case EntityType::BULLET: return fromPlayer ? PLAYER_BULLET : ENEMY_BULLET;
+    case EntityType::BRICK_BLOCK: return BRICK;
+    case EntityType::STEEL_BLOCK: return STEEL;
+    case EntityType::WATER_BLOCK: return WATER;
+    case EntityType::TREE_BLOCK: return TREE;
+    case EntityType::BASE: return BASE;
+    case EntityType::HEALTH_POWERUP:
+    case EntityType::BOMB_POWERUP:
+    case EntityType::SHIELD_POWERUP: return POWERUP;
+    }
+    return TREE;    // Type inconnu : aucune interaction
+}
+
+constexpr Mask SOLID_BLOCKS = bit(BRICK) | bit(STEEL) | bit(WATER) | bit(BASE);
+constexpr Mask BULLETS = bit(PLAYER_BULLET) | bit(ENEMY_BULLET);
+constexpr Mask TANKS = bit(PLAYER_TANK) | bit(ENEMY_TANK);
+
+// Contacts résolus par le moteur (dégâts, destruction, ramassage, répulsion).
+// Les arbres n'arrêtent rien ; chaque camp ne touche que l'autre.
+constexpr Mask CONTACTS[LAYER_COUNT] = {
+    /* PLAYER_TANK   */ bit(ENEMY_TANK) | bit(ENEMY_BULLET) | bit(POWERUP),
+    /* ENEMY_TANK    */ bit(PLAYER_TANK) | bit(PLAYER_BULLET),
+    /* PLAYER_BULLET */ SOLID_BLOCKS | BULLETS | bit(ENEMY_TANK),
+    /* ENEMY_BULLET  */ SOLID_BLOCKS | BULLETS | bit(PLAYER_TANK),
+    /* BRICK         */ BULLETS,
+    /* STEEL         */ BULLETS,
+    /* WATER         */ BULLETS,
+    /* TREE          */ 0,
+    /* BASE          */ BULLETS,
+    /* POWERUP       */ bit(PLAYER_TANK)
+};
+
+// Couches qui arrêtent un tank (et refusent un emplacement d'apparition)
+constexpr Mask MOVEMENT_BLOCKERS = SOLID_BLOCKS | TANKS;
+
+constexpr bool interacts(Layer a, Layer b) { return (CONTACTS[a] & bit(b)) != 0; }
+constexpr bool blocksMovement(Layer layer) { return (MOVEMENT_BLOCKERS & bit(layer)) != 0; }
+
+constexpr bool isSymmetric() {
+    for (int a = 0; a < LAYER_COUNT; a++) {
+        for (int b = 0; b < LAYER_COUNT; b++) {
+            if (interacts(Layer(a), Layer(b)) != interacts(Layer(b), Layer(a))) return false;
+        }
+    }
+    return true;
+}
+static_assert(isSymmetric(), "CONTACTS doit être symétrique");
+
+}
+
+#endif // COLLISIONLAYERS_H
@@ -24,10 +24,17 @@ constexpr int MAX_PLAYER_HEALTH = 3;
 constexpr int MAX_ENEMIES = 15;
 constexpr int ACTIVE_ENEMIES = 3;
 
-// Intervalles de timer (millisecondes) - OPTIMISÉ POUR FLUIDITÉ
-constexpr int GAME_TICK_INTERVAL = 16;   // ~60 FPS pour animation fluide
+// Cadence - la simulation tourne à 60 Hz exacts (voir FrameScheduler)
+constexpr int SIMULATION_RATE = 60;      // Ticks par seconde
+constexpr int DEFAULT_REFRESH_RATE = 60; // Fréquence d'affichage si l'écran est inconnu
+
+// Repaints partiels : au-delà, on redessine toute la zone de jeu
+constexpr int MAX_DIRTY_RECTS = 64;
+
+// Intervalles (millisecondes)
 constexpr int ENEMY_SPAWN_INTERVAL = 4000;
 constexpr int ENEMY_SHOOT_INTERVAL = 2000;
+constexpr int ENEMY_SPAWN_TICKS = ENEMY_SPAWN_INTERVAL * SIMULATION_RATE / 1000;
 
 // Score
 constexpr int ENEMY_KILL_SCORE = 100;
@@ -44,6 +51,7 @@ const QString SETTING_SFX_VOLUME = "sfx_volume";
 namespace Colors {
 // Couleurs par défaut - PLUS VISIBLES
 const QString PLAYER_TANK_DEFAULT = "#FFD700";  // Or
+const QString PARTNER_TANK = "#7CFC00";         // Vert clair (coopération)
 const QString ENEMY_TANK = "#FF4444";           // Rouge
 const QString BRICK_BLOCK = "#D2691E";          // Brun (briques)
 const QString STEEL_BLOCK = "#708090";          // Gris acier
@@ -52,6 +60,8 @@ const QString TREE_BLOCK = "#228B22";           // Vert forêt
 const QString BASE = "#FF0000";                 // Rouge vif
 const QString BULLET = "#FFFF00";               // Jaune brillant
 const QString BACKGROUND = "#000000";           // Noir
+const QString HUD_BACKGROUND = "#1A1A1A";       // Bandeau du HUD
+const QString HUD_TITLE = "#A0A0A0";            // Intitulés du HUD
 
 // Couleurs de power-ups
 const QString HEALTH_POWERUP = "#FF69B4";       // Rose
@@ -5,9 +5,10 @@
 #include "Tank.hpp"
 #include <QTimer>
 
-class Enemy : public Tank {
+class Enemy final : public Tank {
 public:
-    Enemy(const QPointF& position);
+    Enemy(const FixedPoint& position);                  // Graine tirée au hasard
+    Enemy(const FixedPoint& position, quint32 seed);    // IA reproductible
     
     void update() override;
     void updateAI();
@@ -19,12 +20,14 @@ private:
     int m_aiTimer;
     int m_shootTimer;
     int m_directionChangeTimer;
+    quint32 m_randomState;      // xorshift32 : quelques octets par ennemi
     
     static constexpr int AI_UPDATE_INTERVAL = 30;
     static constexpr int SHOOT_INTERVAL = 120;
     static constexpr int DIRECTION_CHANGE_INTERVAL = 60;
     
     Direction getRandomDirection();
+    int nextRandom(int bound);
 };
 
 #endif // ENEMY_H
\ No newline at end of file
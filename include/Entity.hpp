@@ -4,6 +4,7 @@
 #include <QRectF>
 #include <QColor>
 #include <QPainter>
+#include "FixedPoint.hpp"
 
 enum class Direction {
     UP,
@@ -28,29 +29,57 @@ enum class EntityType {
 
 class Entity {
 public:
-    Entity(const QRectF& rect, EntityType type, const QColor& color);
+    Entity(const FixedRect& box, EntityType type, const QColor& color);
     virtual ~Entity() = default;
     
+    // Le moteur range chaque type dans son propre conteneur et les classes
+    // feuilles sont final : ses boucles appellent ces fonctions directement
     virtual void update() {}
     virtual void render(QPainter& painter);
+    virtual QRectF getRenderBounds() const;  // Zone réellement peinte par render()
     
-    QRectF getRect() const { return m_rect; }
-    QPointF getPosition() const { return m_rect.topLeft(); }
+    // Simulation : coordonnées fixes
+    const FixedRect& getBox() const { return m_box; }
+    FixedPoint getFixedPosition() const { return m_box.topLeft(); }
+
+    // Rendu : conversion en flottants au moment du dessin
+    QRectF getRect() const { return m_box.toRectF(); }
+    QPointF getPosition() const { return m_box.topLeft().toPointF(); }
+    QPointF getPreviousPosition() const { return m_previousPosition.toPointF(); }
+    QPointF getInterpolatedPosition(qreal alpha) const;
+    quint32 getId() const { return m_id; }
     EntityType getType() const { return m_type; }
     QColor getColor() const { return m_color; }
     bool isActive() const { return m_active; }
     
-    void setPosition(const QPointF& pos);
+    void setPosition(const FixedPoint& pos) { m_box.moveTo(pos); }
+    void savePreviousPosition() { m_previousPosition = m_box.topLeft(); }
     void setColor(const QColor& color) { m_color = color; }
     void setActive(bool active) { m_active = active; }
     
     bool collidesWith(const Entity& other) const;
+
+    // Passe de collision : modifiée (position ou activité) depuis la passe
+    // précédente ? Une paire de deux entités inchangées garde son résultat.
+    bool refreshCollisionState() {
+        m_collisionDirty = m_active != m_checkedActive || m_box.topLeft() != m_checkedPosition;
+        m_checkedPosition = m_box.topLeft();
+        m_checkedActive = m_active;
+        return m_collisionDirty;
+    }
+    bool isCollisionDirty() const { return m_collisionDirty; }
+    void markCollisionDirty() { m_collisionDirty = true; }   // Déplacée pendant la passe
     
 protected:
-    QRectF m_rect;
+    quint32 m_id;                // Unique pour toute la partie (événements)
+    FixedRect m_box;
+    FixedPoint m_previousPosition;  // Position au tick précédent (interpolation)
     EntityType m_type;
     QColor m_color;
     bool m_active;
+    FixedPoint m_checkedPosition;   // État à la dernière passe de collision
+    bool m_checkedActive;
+    bool m_collisionDirty;          // Une entité neuve compte comme modifiée
 };
 
 #endif // ENTITY_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
+#include <QtGlobal>
+
+// Coordonnées de la simulation en virgule fixe 24.8 (256 unités par pixel).
+// Les calculs entiers donnent le même résultat au bit près quel que soit le
+// compilateur ou le processeur ; les flottants n'apparaissent qu'au rendu.
+namespace Fixed {
+constexpr int FRACTION_BITS = 8;
+constexpr qint32 ONE = 1 << FRACTION_BITS;
+
+constexpr qint32 fromPixels(int pixels) { return pixels * ONE; }
+constexpr qreal toReal(qint32 value) { return static_cast<qreal>(value) / ONE; }
+inline qint32 fromReal(qreal value) { return qRound(value * ONE); }
+
+// Racine carrée entière (partie entière), méthode bit à bit
+constexpr quint64 isqrt(quint64 value) {
+    quint64 result = 0;
+    quint64 bit = quint64(1) << 62;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+}
+
+struct FixedPoint {
+    qint32 x = 0;
+    qint32 y = 0;
+
+    constexpr FixedPoint() = default;
+    constexpr FixedPoint(qint32 fx, qint32 fy) : x(fx), y(fy) {}
+
+    static constexpr FixedPoint fromPixels(int px, int py) {
+        return FixedPoint(Fixed::fromPixels(px), Fixed::fromPixels(py));
+    }
+    static FixedPoint fromPixels(const QPoint& point) { return fromPixels(point.x(), point.y()); }
+    static FixedPoint fromPointF(const QPointF& point) {
+        return FixedPoint(Fixed::fromReal(point.x()), Fixed::fromReal(point.y()));
+    }
+    QPointF toPointF() const { return QPointF(Fixed::toReal(x), Fixed::toReal(y)); }
+
+    // Distance euclidienne, en unités fixes
+    qint32 length() const {
+        const qint64 dx = x;
+        const qint64 dy = y;
+        return static_cast<qint32>(Fixed::isqrt(static_cast<quint64>(dx * dx + dy * dy)));
+    }
+
+    constexpr FixedPoint operator+(const FixedPoint& other) const { return FixedPoint(x + other.x, y + other.y); }
+    constexpr FixedPoint operator-(const FixedPoint& other) const { return FixedPoint(x - other.x, y - other.y); }
+    constexpr bool operator==(const FixedPoint& other) const { return x == other.x && y == other.y; }
+    constexpr bool operator!=(const FixedPoint& other) const { return !(*this == other); }
+};
+
+// Boîte alignée sur les axes ; right() et bottom() sont exclusifs, comme
+// QRectF, et deux boîtes qui se touchent seulement ne s'intersectent pas
+struct FixedRect {
+    qint32 x = 0;
+    qint32 y = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+
+    constexpr FixedRect() = default;
+    constexpr FixedRect(qint32 fx, qint32 fy, qint32 w, qint32 h) : x(fx), y(fy), width(w), height(h) {}
+    constexpr FixedRect(const FixedPoint& topLeft, qint32 w, qint32 h) : x(topLeft.x), y(topLeft.y), width(w), height(h) {}
+
+    static constexpr FixedRect fromPixels(int px, int py, int w, int h) {
+        return FixedRect(Fixed::fromPixels(px), Fixed::fromPixels(py), Fixed::fromPixels(w), Fixed::fromPixels(h));
+    }
+    // Boîte carrée de côté size pixels
+    static constexpr FixedRect square(const FixedPoint& topLeft, int size) {
+        return FixedRect(topLeft, Fixed::fromPixels(size), Fixed::fromPixels(size));
+    }
+    QRectF toRectF() const {
+        return QRectF(Fixed::toReal(x), Fixed::toReal(y), Fixed::toReal(width), Fixed::toReal(height));
+    }
+
+    constexpr qint32 left() const { return x; }
+    constexpr qint32 top() const { return y; }
+    constexpr qint32 right() const { return x + width; }
+    constexpr qint32 bottom() const { return y + height; }
+    constexpr FixedPoint topLeft() const { return FixedPoint(x, y); }
+    constexpr FixedPoint center() const { return FixedPoint(x + width / 2, y + height / 2); }
+
+    constexpr void moveTo(const FixedPoint& topLeft) { x = topLeft.x; y = topLeft.y; }
+
+    constexpr bool intersects(const FixedRect& other) const {
+        return x < other.x + other.width && other.x < x + width &&
+               y < other.y + other.height && other.y < y + height;
+    }
+};
+
+#endif // FIXEDPOINT_H
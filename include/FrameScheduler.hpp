@@ -0,0 +1,69 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <vector>
+#include "Constants.hpp"
+
+// Statistiques de cadence exportées par le FrameScheduler
+struct FrameStats {
+    double meanIntervalMs = 0.0;   // Intervalle moyen entre deux frames
+    double p99IntervalMs = 0.0;    // 99e percentile de cet intervalle
+    double maxIntervalMs = 0.0;
+    quint64 frames = 0;
+    quint64 ticks = 0;             // Pas de simulation exécutés
+    quint64 missedTicks = 0;       // Pas abandonnés faute de temps
+    quint64 spiralEvents = 0;      // Frames où le rattrapage a atteint sa limite
+};
+
+// Boucle à pas fixe : un timer précis cadencé sur l'écran accumule le temps
+// réel et déclenche autant de ticks de simulation que nécessaire, dans la
+// limite de MAX_CATCHUP_TICKS par frame. Au-delà, le retard est abandonné
+// (et compté) plutôt que de laisser la simulation s'emballer.
+class FrameScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FrameScheduler(QObject* parent = nullptr);
+
+    void start();    // Repart d'un accumulateur vide
+    void resume();   // Reprend sans compter le temps passé à l'arrêt
+    void stop();
+    bool isRunning() const { return m_timer->isActive(); }
+
+    void setDisplayRefreshRate(qreal hz);
+    qreal getInterpolationAlpha() const;
+
+    FrameStats getStats() const;
+    void resetStats();
+
+    static constexpr qint64 TICK_NS = 1000000000LL / GameConstants::SIMULATION_RATE;
+    static constexpr int MAX_CATCHUP_TICKS = 5;
+    static constexpr int INTERVAL_HISTORY = 600;          // ~10 s de frames
+    static constexpr qint64 STATS_LOG_INTERVAL_NS = 10000000000LL;
+
+signals:
+    void tick();     // Un pas de simulation
+    void frame();    // Une frame d'affichage, après les ticks
+
+private slots:
+    void onTimeout();
+
+private:
+    void recordInterval(qint64 intervalNs);
+    void logStats();
+
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_lastFrameTime;    // ns
+    qint64 m_accumulator;      // ns de simulation en attente
+    qint64 m_lastStatsLog;     // ns
+
+    std::vector<qint64> m_intervals;  // Tampon circulaire
+    size_t m_intervalIndex;
+    FrameStats m_stats;
+};
+
+#endif // FRAMESCHEDULER_H
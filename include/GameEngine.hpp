@@ -2,7 +2,10 @@
 #define GAMEENGINE_H
 
 #include <QObject>
-#include <QTimer>
+#include <QFuture>
+#include <QRegion>
+#include <QStringList>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include "Tank.hpp"
@@ -10,6 +13,11 @@
 #include "Bullet.hpp"
 #include "Block.hpp"
 #include "PowerUp.hpp"
+#include "FrameScheduler.hpp"
+#include "LevelLayout.hpp"
+#include "GameEvent.hpp"
+#include "InputQueue.hpp"
+#include <QRandomGenerator>
 
 enum class GameState {
     MENU,
@@ -19,6 +27,54 @@ enum class GameState {
     LEVEL_COMPLETE
 };
 
+// Terrain et départs d'un niveau, construits hors du thread principal
+struct PreparedLevel {
+    int level = 1;
+    quint32 seed = 0;
+    std::vector<std::unique_ptr<Block>> blocks;
+    FixedPoint playerStart;
+    std::vector<FixedPoint> spawnPoints;
+    std::vector<LevelWave> waves;
+};
+
+// État complet de la simulation pour revenir à un tick passé (rollback
+// réseau). Les entités sont copiées : le terrain, les vagues et les départs
+// ne changent pas pendant un niveau et ne sont pas sauvegardés.
+struct EngineSnapshot {
+    GameState state = GameState::MENU;
+    std::unique_ptr<Tank> player;
+    std::unique_ptr<Tank> partner;
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    std::vector<std::unique_ptr<Bullet>> bullets;
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<std::unique_ptr<PowerUp>> powerUps;
+    QRandomGenerator random;
+    int score = 0;
+    size_t waveIndex = 0;
+    int waveSpawned = 0;
+    int enemiesRemaining = 0;
+    int activeEnemies = 0;
+    bool baseDestroyed = false;
+    quint64 tickCount = 0;
+    int spawnTickCounter = 0;
+    std::vector<InputEvent> carriedInput;
+};
+
+// Réglages d'équilibrage, propres à chaque moteur (simulations en lot)
+struct GameTuning {
+    int powerUpDropPercent = 30;   // Chance qu'un ennemi détruit lâche un power-up
+    int spawnIntervalTicks = 0;    // 0 = cadence des vagues du niveau
+};
+
+// Contact trouvé par la phase étroite des balles. La détection ne modifie
+// rien ; la réponse retient le premier contact encore actif de chaque balle.
+struct BulletContact {
+    enum Kind : quint8 { BLOCK, ENEMY, PLAYER, BULLET };
+    quint32 bullet;     // Indice dans m_bullets
+    quint32 other;      // Indice dans le conteneur du type (PLAYER : 0 joueur, 1 partenaire)
+    Kind kind;
+};
+
 class GameEngine : public QObject {
     Q_OBJECT
 
@@ -30,13 +86,87 @@ public:
     void pauseGame();
     void resumeGame();
     void restartGame();
+    void nextLevel();   // Depuis LEVEL_COMPLETE : score conservé, niveau préparé en fond
     void quitToMenu();
 
+    // Même graine, mêmes entrées : même partie (terrain, IA, power-ups)
+    void setSeed(quint32 seed) { m_random.seed(seed); }
+    void setTuning(const GameTuning& tuning) { m_tuning = tuning; }
+    const GameTuning& getTuning() const { return m_tuning; }
+
+    // Détection des collisions répartie sur les cœurs au-delà de
+    // PARALLEL_NARROW_PHASE_MIN balles ; même résultat qu'en série
+    void setParallelCollisions(bool enabled) { m_parallelCollisions = enabled; }
+
+    // Niveau suivant construit en fond à la fin d'un niveau ; inutile aux
+    // boucles sans interface, qui relancent la partie au lieu d'enchaîner
+    void setPreloadNextLevel(bool enabled) { m_preloadNextLevel = enabled; }
+
+    // Boucles sans interface (lots, entraînement, serveur, replays, --stress) :
+    // niveau 1 installé et partie en cours, sans démarrer le FrameScheduler.
+    // La graine n'est pas retirée : une relance continue la même série.
+    void startHeadless();
+    void stepTick() { update(); }   // Un tick, cadencé par l'appelant
+
+    // Moteur cadencé de l'extérieur (LockstepSession) : le FrameScheduler
+    // n'appelle plus update(), l'appelant s'abonne à son tick et annonce
+    // lui-même les fins de partie
+    FrameScheduler* detachScheduler();
+    void takeInput(std::vector<InputEvent>& out) { m_input.takeAll(out); }   // Entrées en file, non appliquées
+    void setResimulating(bool resimulating) { m_resimulating = resimulating; }   // Ticks rejoués sans événements
+
+    // Scènes construites à la main (--stress, benchmarks), hors des vagues
+    void addEnemy(std::unique_ptr<Enemy> enemy);
+    void addBullet(std::unique_ptr<Bullet> bullet) { m_bullets.push_back(std::move(bullet)); }
+    void addBlock(std::unique_ptr<Block> block) { m_blocks.push_back(std::move(block)); }
+    void addPowerUp(std::unique_ptr<PowerUp> powerUp) { m_powerUps.push_back(std::move(powerUp)); }
+    template <typename Predicate>
+    void removeBlocksIf(Predicate predicate) {
+        m_blocks.erase(std::remove_if(m_blocks.begin(), m_blocks.end(), predicate), m_blocks.end());
+    }
+    void clearBlocks() { m_blocks.clear(); }
+    void clearBullets() { m_bullets.clear(); }
+    void stopWaves() { m_enemiesRemaining = 0; }   // Population gérée par l'appelant
+    void reviveHeadless();   // Partie remise en cours, base intacte, quelle qu'ait été l'issue
+
+    // Phases d'un tick appelées isolément (tank_bench)
+    bool isValidMove(const FixedRect& box, Entity* ignore = nullptr);
+    void checkBulletCollisions();
+    void cleanupInactive();
+    void createLevel();
+
+    // 2 = coopération : un tank partenaire piloté par les entrées du joueur 1
+    void setPlayerCount(int count) { m_playerCount = qBound(1, count, 2); }
+    int getPlayerCount() const { return m_playerCount; }
+
+    // Lockstep : sauvegarde et restauration d'un tick, empreinte de l'état
+    void saveSnapshot(EngineSnapshot& snapshot) const;
+    void restoreSnapshot(const EngineSnapshot& snapshot);
+    quint64 stateHash() const;
+    // Partie réseau : pause, relance et niveau suivant sont refusés localement
+    bool isSessionDriven() const { return m_sessionDriven; }
+
+    // Niveaux compilés (.lvl) joués dans l'ordre, en boucle ; vide = niveaux générés
+    void setCampaign(const QStringList& levelFiles);
+
+    // Entrées mises en file, appliquées au début du prochain tick
     void processInput(int key, bool pressed);
     void playerShoot();
+    void submitInput(InputAction action, bool pressed);
+    void submitInput(const InputEvent& event);   // Replays, joueurs distants
+
+    // Cadence d'affichage : les frames suivent l'écran, la simulation reste à pas fixe
+    void setDisplayRefreshRate(qreal hz);
+    qreal getInterpolationAlpha() const;
+    FrameStats getFrameStats() const { return m_scheduler->getStats(); }
+
+    // Zones modifiées depuis le dernier appel (anciennes et nouvelles bornes)
+    QRegion takeDirtyRegion();
+    quint64 getTickCount() const { return m_tickCount; }
 
     GameState getState() const { return m_state; }
     Tank* getPlayer() const { return m_player.get(); }
+    Tank* getPartner() const { return m_partner.get(); }
     const std::vector<std::unique_ptr<Enemy>>& getEnemies() const { return m_enemies; }
     const std::vector<std::unique_ptr<Bullet>>& getBullets() const { return m_bullets; }
     const std::vector<std::unique_ptr<Block>>& getBlocks() const { return m_blocks; }
@@ -51,42 +181,116 @@ signals:
     void scoreChanged(int score);
     void playerHealthChanged(int health);
     void levelChanged(int level);
-    void soundEffect(const QString& effect);
+    void gameEvents(const GameEventList& events);   // Une fois par tick, si non vide
+    void frameAdvanced();
+    void tickCompleted();   // Après chaque tick simulé (enregistrement de replay)
 
 private slots:
     void update();
-    void spawnEnemy();
 
 private:
-    void initializeLevel();
-    void createLevel();
+    void spawnEnemy();
+    void initializeLevel(std::shared_ptr<PreparedLevel> prepared = nullptr);
+    void installLevel(PreparedLevel& level);
+    void prepareNextLevel();
+
+    // Sans état : appelables depuis un thread de travail
+    static std::shared_ptr<PreparedLevel> buildLevel(int levelNumber, const QStringList& campaign, quint32 seed);
+    static bool loadLevel(const QString& path, PreparedLevel& level);
+    static void generateLevel(PreparedLevel& level);
+    void applyInput();
+    void applyInputEvent(const InputEvent& event);
+    void firePlayerBullet(Tank& tank);
+    void updatePlayerTank(Tank& tank);
+    void createPartner();
+    bool anyPlayerActive() const;
     void checkCollisions();
-    void checkBulletCollisions();
+
+    // Phase étroite des balles : une tranche par tâche, chacune son tampon
+    struct NarrowPhaseChunk {
+        size_t first = 0;
+        size_t last = 0;
+        std::vector<BulletContact> contacts;
+    };
+    void findBulletContacts(NarrowPhaseChunk& chunk) const;
+    bool applyBulletContact(Bullet& bullet, const BulletContact& contact);
     void checkPowerUpCollisions();
+    void collectPowerUp(PowerUp& powerUp);
     void checkTankCollisions();  // NOUVEAU - collision tank-tank
+    bool pushPlayerAway(Tank& player, const Enemy& enemy);   // Vrai si le joueur a bougé
     void updateEnemies();
-    void cleanupInactive();
-    void spawnPowerUp(const QPointF& position = QPointF());  // Position optionnelle
+    void spawnPowerUp(const FixedPoint& position = FixedPoint());  // Position optionnelle
     void triggerBomb();
 
-    bool isValidMove(const QRectF& rect, Entity* ignore = nullptr);
-    QPointF getSpawnPosition(int index);
+    void savePreviousPositions();
+    void markDirty(const QRectF& bounds);
+    template <typename T>
+    void markEntityDirty(const T& entity);   // Bornes du type exact, sans appel virtuel
+    void markChangedEntities();
+    void markFullRepaint();
+
+    // Collecte sans allocation de chaîne ; diffusion groupée en fin de tick
+    void pushEvent(GameEventType type, const Entity& entity) {
+        m_events.push_back(GameEvent{type, entity.getId(), entity.getRect().center()});
+    }
+    void dispatchEvents();
+    static FixedPoint getSpawnPosition(int index);
+
+    static constexpr int SPAWN_POINTS = 3;
+    static constexpr size_t NARROW_PHASE_CHUNK = 64;           // Balles par tâche
+    static constexpr size_t PARALLEL_NARROW_PHASE_MIN = 256;   // En dessous, une tâche coûte plus qu'elle ne rapporte
 
     GameState m_state;
     std::unique_ptr<Tank> m_player;
+    std::unique_ptr<Tank> m_partner;    // Seulement en coopération
+    int m_playerCount;
     std::vector<std::unique_ptr<Enemy>> m_enemies;
     std::vector<std::unique_ptr<Bullet>> m_bullets;
     std::vector<std::unique_ptr<Block>> m_blocks;
     std::vector<std::unique_ptr<PowerUp>> m_powerUps;
 
-    QTimer* m_gameTimer;
-    QTimer* m_enemySpawnTimer;
+    FrameScheduler* m_scheduler;
+
+    QRandomGenerator m_random;  // Seule source d'aléa de la simulation
+    GameTuning m_tuning;
+    bool m_parallelCollisions;
+    bool m_preloadNextLevel;
+    std::vector<NarrowPhaseChunk> m_narrowPhase;
+    std::vector<size_t> m_changedEnemies;    // Indices modifiés depuis la passe précédente
+    std::vector<size_t> m_changedPowerUps;
 
     int m_score;
     int m_level;
+    quint32 m_levelSeed;        // Graine du terrain, pour reproduire un niveau
+    QStringList m_campaign;
+
+    // Départs et vagues du niveau en cours
+    FixedPoint m_playerStart;
+    std::vector<FixedPoint> m_spawnPoints;
+    std::vector<LevelWave> m_waves;
+    size_t m_waveIndex;
+    int m_waveSpawned;          // Ennemis déjà apparus dans la vague en cours
+    QFuture<std::shared_ptr<PreparedLevel>> m_nextLevel;
+
     int m_enemiesRemaining;
     int m_activeEnemies;
     bool m_baseDestroyed;
+
+    quint64 m_tickCount;
+    int m_spawnTickCounter;     // Ticks depuis la dernière apparition d'ennemi
+
+    std::vector<QRect> m_dirtyRects;
+    bool m_dirtyOverflow;       // Trop de zones : tout redessiner
+
+    InputQueue m_input;
+    std::vector<InputEvent> m_tickInput;     // Entrées du tick en cours
+    std::vector<InputEvent> m_carriedInput;  // Relâchements reportés au tick suivant
+
+    GameEventList m_events;     // Événements du tick en cours
+    bool m_scoreDirty;          // scoreChanged à émettre en fin de tick
+    bool m_healthDirty;         // playerHealthChanged à émettre en fin de tick
+    bool m_resimulating;        // Rollback : ticks rejoués sans événements
+    bool m_sessionDriven;       // LockstepSession : une fin peut n'être que prédite, la session l'annonce
 };
 
 #endif // GAMEENGINE_H
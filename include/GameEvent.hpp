@@ -0,0 +1,43 @@
+#ifndef GAMEEVENT_H
+#define GAMEEVENT_H
+
+#include <QPointF>
+#include <vector>
+
+// Événements de la simulation (sons, effets, statistiques)
+enum class GameEventType : quint8 {
+    PLAYER_SHOOT,
+    ENEMY_SHOOT,
+    ENEMY_SPAWN,
+    ENEMY_DESTROYED,
+    PLAYER_HIT,
+    BLOCK_DESTROYED,
+    BASE_DESTROYED,
+    POWERUP_HEALTH,
+    POWERUP_BOMB,
+    POWERUP_SHIELD,
+    COUNT
+};
+
+constexpr int GAME_EVENT_TYPE_COUNT = static_cast<int>(GameEventType::COUNT);
+
+// Valeur pure : l'entité peut avoir disparu quand le lot est diffusé
+struct GameEvent {
+    GameEventType type;
+    quint32 entityId;
+    QPointF position;   // Centre de l'entité au moment de l'événement
+};
+
+// Lot collecté pendant un tick et diffusé une seule fois à sa fin
+using GameEventList = std::vector<GameEvent>;
+
+// Nom stable (fichiers son, journaux) ; jamais utilisé dans la boucle
+inline const char* gameEventName(GameEventType type) {
+    static constexpr const char* NAMES[GAME_EVENT_TYPE_COUNT] = {
+        "player_shoot", "enemy_shoot", "enemy_spawn", "enemy_destroyed", "player_hit",
+        "block_destroyed", "base_destroyed", "powerup_health", "powerup_bomb", "powerup_shield"
+    };
+    return type < GameEventType::COUNT ? NAMES[static_cast<int>(type)] : "unknown";
+}
+
+#endif // GAMEEVENT_H
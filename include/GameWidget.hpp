@@ -4,30 +4,91 @@
 #include <QWidget>
 #include <QPainter>
 #include <QKeyEvent>
+#include <QRegion>
+#include <QStaticText>
+#include <memory>
 #include "GameEngine.hpp"
+#include "SoftwareRenderer.hpp"
 
 class GameWidget : public QWidget {
     Q_OBJECT
+
+    // Benchmark de rendu hors écran : choix du moteur de rendu
+    friend class RenderBench;
     
 public:
     explicit GameWidget(GameEngine* engine, QWidget* parent = nullptr);
     
 protected:
     void paintEvent(QPaintEvent* event) override;
+    void showEvent(QShowEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
     void keyReleaseEvent(QKeyEvent* event) override;
     
 private:
+    void onFrameAdvanced();
+    bool needsRepaint(const QRectF& bounds) const;
+
+    void setSoftwareRendering(bool enabled);
+    void renderFrame(QPainter& painter);
+    void renderSoftware(QPainter& painter);
+
+    QRect gameAreaRect() const;
+    QRect hudRect() const;
+    bool refreshHud();
+    void renderHud(QPainter& painter);
+
+    QRect profilerOverlayRect() const;
+    void renderProfilerOverlay(QPainter& painter);
+    void exportProfilerTrace();
+
     void renderGame(QPainter& painter);
+    template <typename T>
+    void renderInterpolated(QPainter& painter, T& entity);
     void renderBlocks(QPainter& painter);
     void renderTanks(QPainter& painter);
     void renderBullets(QPainter& painter);
     void renderPowerUps(QPainter& painter);
+    QColor overlayColor(GameState state) const;
+    void renderOverlayText(QPainter& painter, GameState state);
     void renderPauseScreen(QPainter& painter);
     void renderGameOverScreen(QPainter& painter);
     void renderLevelCompleteScreen(QPainter& painter);
     
     GameEngine* m_engine;
+    qreal m_alpha;  // Facteur d'interpolation de la frame en cours
+
+    // Zones sales des deux derniers ticks : l'interpolation dessine
+    // entre la position précédente et la position courante
+    QRegion m_lastTickRegion;
+    QRegion m_previousTickRegion;
+    quint64 m_lastTick;
+    QRegion m_paintRegion;  // Région du paintEvent en cours
+
+    // Rendu logiciel optionnel (F2), nul quand QPainter dessine directement
+    std::unique_ptr<SoftwareRenderer> m_softwareRenderer;
+
+    // HUD sous la zone de jeu : valeurs relues une fois par frame, texte
+    // préparé (QStaticText) seulement quand une valeur change
+    struct HudValues {
+        int health = -1;
+        int score = -1;
+        int level = -1;
+        int enemies = -1;
+    };
+    HudValues m_hud;
+    QFont m_hudTitleFont;
+    QFont m_hudValueFont;
+    QStaticText m_hudTitles[4];   // Vie, score, niveau, ennemis
+    QStaticText m_hudScore;
+    QStaticText m_hudLevel;
+    QStaticText m_hudEnemies;
+    QStaticText m_hudHealth;
+
+    // Overlay du profileur (F3), redessiné à chaque frame quand il est visible
+    bool m_showProfiler;
+    static constexpr int PROFILER_GRAPH_HEIGHT = 100;
+    static constexpr qreal PROFILER_GRAPH_MS = 33.3;  // Hauteur du graphe en ms
 };
 
 #endif // GAMEWIDGET_H
@@ -0,0 +1,41 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <QtGlobal>
+#include <vector>
+
+// Actions du joueur, indépendantes des touches
+enum class InputAction : quint8 {
+    MOVE_UP,
+    MOVE_DOWN,
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    SHOOT
+};
+
+struct InputEvent {
+    InputAction action;
+    bool pressed;         // Toujours vrai pour SHOOT
+    quint8 player = 0;    // 0 = joueur principal, 1 = partenaire (coopération)
+};
+
+// File d'entrées dans l'ordre d'arrivée, vidée par le moteur au début de chaque tick.
+// Le clavier, les replays et les joueurs distants y déposent leurs événements.
+class InputQueue {
+public:
+    void push(const InputEvent& event) { m_pending.push_back(event); }
+
+    // Échange avec le tampon de l'appelant : pas d'allocation en régime établi
+    void takeAll(std::vector<InputEvent>& out) {
+        out.clear();
+        out.swap(m_pending);
+    }
+
+    void clear() { m_pending.clear(); }
+    bool isEmpty() const { return m_pending.empty(); }
+
+private:
+    std::vector<InputEvent> m_pending;
+};
+
+#endif // INPUTQUEUE_H
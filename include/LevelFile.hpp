@@ -0,0 +1,75 @@
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QPoint>
+#include <QString>
+#include "LevelLayout.hpp"
+
+// Format binaire des niveaux (.lvl), petit-boutiste :
+//   en-tête      32 octets (voir LevelFileHeader)
+//   cases        width × height octets (valeurs de Tile), ligne par ligne
+//   remplissage  jusqu'à un multiple de 4
+//   apparitions  spawnCount × { quint16 x, quint16 y }
+//   vagues       waveCount × { quint16 enemies, interval, maxActive, réservé }
+struct LevelFileHeader {
+    char magic[4];
+    quint16 version;
+    quint16 width;
+    quint16 height;
+    quint16 spawnCount;
+    quint16 waveCount;
+    quint16 playerX;
+    quint16 playerY;
+    quint16 reserved[7];
+};
+static_assert(sizeof(LevelFileHeader) == 32, "en-tête de niveau sur 32 octets");
+
+// Niveau compilé, projeté en mémoire : les cases sont lues directement dans
+// le fichier, sans copie ni allocation par case
+class LevelFile {
+public:
+    LevelFile() = default;
+    ~LevelFile();
+
+    LevelFile(const LevelFile&) = delete;
+    LevelFile& operator=(const LevelFile&) = delete;
+
+    bool open(const QString& path);
+    void close();
+    QString errorString() const { return m_error; }
+
+    int width() const { return m_header.width; }
+    int height() const { return m_header.height; }
+    Tile tileAt(int x, int y) const { return static_cast<Tile>(m_tiles[y * m_header.width + x]); }
+    QPoint playerSpawn() const { return QPoint(m_header.playerX, m_header.playerY); }
+
+    int spawnCount() const { return m_header.spawnCount; }
+    QPoint spawnAt(int index) const;
+    int waveCount() const { return m_header.waveCount; }
+    LevelWave waveAt(int index) const;
+
+    // Compilation depuis le format texte (outil tank_levelc)
+    static bool parseAscii(const QByteArray& text, LevelLayout& layout, QString* error);
+    static QByteArray serialize(const LevelLayout& layout);
+
+    static constexpr char MAGIC[4] = {'T', 'N', 'K', 'L'};
+    static constexpr quint16 VERSION = 1;
+    static constexpr int SPAWN_ENTRY_SIZE = 4;
+    static constexpr int WAVE_ENTRY_SIZE = 8;
+
+private:
+    bool fail(const QString& error);
+    static qint64 spawnsOffset(int width, int height);
+
+    QFile m_file;
+    uchar* m_data = nullptr;
+    LevelFileHeader m_header = {};
+    const uchar* m_tiles = nullptr;
+    const uchar* m_spawns = nullptr;
+    const uchar* m_waves = nullptr;
+    QString m_error;
+};
+
+#endif // LEVELFILE_H
@@ -0,0 +1,48 @@
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include <QPoint>
+#include <QRect>
+#include <QRandomGenerator>
+#include <vector>
+#include "LevelLayout.hpp"
+
+// Contraintes d'un niveau à générer (coordonnées en cases)
+struct LevelSpec {
+    int width = 0;
+    int height = 0;
+    QPoint target;                  // Case à protéger (la base)
+    std::vector<QPoint> sources;    // Points d'apparition, tous reliés à la base
+    std::vector<QRect> clearAreas;  // Zones laissées vides (spawns, base)
+};
+
+// Générateur de niveaux reproductible : automate cellulaire pour le terrain,
+// puis vérification par remplissage sur bitboard (une ligne = un ou
+// plusieurs mots de 64 bits) que chaque point d'apparition atteint la base.
+// Les niveaux non connexes sont réparés en creusant un couloir dans l'acier
+// et l'eau, puis revérifiés ; un échec relance le tirage.
+class LevelGenerator {
+public:
+    explicit LevelGenerator(quint32 seed);
+
+    LevelLayout generate(const LevelSpec& spec);
+
+    // Cases accessibles depuis une case de départ : wordsPerRow(largeur)
+    // mots par ligne, la case x dans le bit x % 64 du mot x / 64
+    static std::vector<quint64> reachableFrom(const LevelLayout& layout, const QPoint& start);
+    static bool isConnected(const LevelLayout& layout, const LevelSpec& spec);
+    static int wordsPerRow(int width) { return (width + 63) / 64; }
+
+    static constexpr int MAX_ATTEMPTS = 8;            // Tirages avant le terrain vide de secours
+    static constexpr int INITIAL_WALL_PERCENT = 43;   // ~20% de cases occupées après lissage
+    static constexpr int SMOOTHING_STEPS = 2;
+
+private:
+    void fillCellular(LevelLayout& layout, const LevelSpec& spec);
+    void repair(LevelLayout& layout, const LevelSpec& spec);
+    void carveCorridor(LevelLayout& layout, const QPoint& from, const QPoint& to);
+
+    QRandomGenerator m_random;
+};
+
+#endif // LEVELGENERATOR_H
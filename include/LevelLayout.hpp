@@ -0,0 +1,61 @@
+#ifndef LEVELLAYOUT_H
+#define LEVELLAYOUT_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <vector>
+#include "Constants.hpp"
+
+// Contenu d'une case de la grille
+enum class Tile : quint8 {
+    EMPTY,
+    BRICK,
+    STEEL,
+    WATER,
+    TREE,
+    BASE
+};
+
+// Vague d'ennemis : apparitions espacées, nombre de tanks simultanés limité
+struct LevelWave {
+    quint16 enemies = 0;
+    quint16 spawnIntervalTicks = 0;
+    quint16 maxActive = 0;
+};
+
+// Rythme des niveaux générés et des niveaux sans vague déclarée : une seule vague
+inline LevelWave defaultWave() {
+    LevelWave wave;
+    wave.enemies = GameConstants::MAX_ENEMIES;
+    wave.spawnIntervalTicks = GameConstants::ENEMY_SPAWN_TICKS;
+    wave.maxActive = GameConstants::ACTIVE_ENEMIES;
+    return wave;
+}
+
+// Terrain d'un niveau en cases, ligne par ligne
+struct LevelLayout {
+    int width = 0;
+    int height = 0;
+    std::vector<Tile> tiles;
+
+    // Niveaux dessinés à la main uniquement (vides pour un niveau généré)
+    std::vector<QPoint> spawns;     // Cases d'apparition des ennemis
+    std::vector<LevelWave> waves;
+    QPoint playerSpawn = QPoint(-1, -1);
+
+    LevelLayout() = default;
+    LevelLayout(int w, int h)
+        : width(w), height(h), tiles(static_cast<size_t>(w) * h, Tile::EMPTY) {}
+
+    bool contains(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+    Tile at(int x, int y) const { return tiles[static_cast<size_t>(y) * width + x]; }
+    void set(int x, int y, Tile tile) { tiles[static_cast<size_t>(y) * width + x] = tile; }
+
+    // Les tanks ne franchissent ni l'acier ni l'eau ; les briques se détruisent
+    bool isPassable(int x, int y) const {
+        const Tile tile = at(x, y);
+        return tile != Tile::STEEL && tile != Tile::WATER;
+    }
+};
+
+#endif // LEVELLAYOUT_H
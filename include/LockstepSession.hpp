@@ -0,0 +1,169 @@
+#ifndef LOCKSTEPSESSION_H
+#define LOCKSTEPSESSION_H
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QRandomGenerator>
+#include <QUdpSocket>
+#include <QTimer>
+#include <array>
+#include <deque>
+#include "GameEngine.hpp"
+#include "StateSnapshot.hpp"
+
+class ReplayWriter;
+
+struct LockstepConfig {
+    quint16 localPort = 0;          // 0 = port choisi par le système (client)
+    QHostAddress peerAddress;       // Nul = hôte, attend le pair
+    quint16 peerPort = 0;
+    int inputDelay = 2;             // Ticks entre la saisie et son application
+    int latencyMs = 0;              // Latence simulée à l'envoi (tests en boucle locale)
+    int lossPercent = 0;            // Paquets perdus volontairement à l'envoi
+    quint32 seed = 0;               // Hôte : 0 = graine tirée au hasard
+    int tickLimit = 0;              // 0 = sans fin ; sinon arrêt après ce tick
+};
+
+struct LockstepStats {
+    quint64 rollbacks = 0;
+    quint64 rolledBackTicks = 0;
+    int maxRollback = 0;
+    quint64 stalls = 0;             // Ticks retenus faute d'entrées distantes
+    quint64 packetsSent = 0;
+    quint64 packetsDropped = 0;     // Pertes simulées
+    quint64 packetsReceived = 0;
+    quint64 bytesSent = 0;
+    quint64 hashesChecked = 0;
+    quint64 desyncs = 0;
+};
+
+// Mode deux joueurs en lockstep sur UDP : chaque pair fait tourner son propre
+// GameEngine et n'échange que ses entrées, un octet par tick. Les entrées
+// locales sont appliquées avec inputDelay ticks de retard ; celles du pair
+// sont prédites (dernières touches connues) et, si la prédiction était
+// fausse, la simulation revient au tick fautif et rejoue jusqu'au présent.
+// Une empreinte de l'état est échangée tous les HASH_INTERVAL ticks pour
+// détecter les désynchronisations.
+class LockstepSession : public QObject {
+    Q_OBJECT
+
+public:
+    LockstepSession(GameEngine* engine, const LockstepConfig& config, QObject* parent = nullptr);
+
+    bool start();   // Ouvre le socket ; l'hôte attend, le client se présente
+    QString errorString() const { return m_error; }
+
+    int localPlayer() const { return m_localPlayer; }
+    quint32 currentTick() const { return m_tick; }
+    quint32 endTick() const { return m_endTick; }    // Ticks joués, une fois la partie finie
+    const LockstepStats& getStats() const { return m_stats; }
+    quint64 confirmedHash() const;     // Empreinte du dernier tick confirmé
+
+    // --record : seuls les ticks confirmés sont écrits, jamais un tick
+    // prédit puis corrigé par un retour arrière
+    void setRecorder(ReplayWriter* writer);
+
+    // Options --host/--connect/--input-delay/--net-latency/--net-loss,
+    // partagées par l'interface et le mode --net-bot
+    static void addCommandLineOptions(QCommandLineParser& parser);
+    static bool configFromCommandLine(const QCommandLineParser& parser, LockstepConfig& config);
+
+    // Mode --net-bot : deux processus sans interface pilotés par BotPlayer
+    static int runFromCommandLine(const QCoreApplication& app);
+
+    static constexpr int MAX_ROLLBACK = 8;        // Au-delà, on attend le pair
+    static constexpr int HISTORY = 128;           // Ticks gardés (puissance de 2)
+    static constexpr int MAX_INPUTS_PER_PACKET = 64;
+    static constexpr int HASH_INTERVAL = 30;      // Ticks entre deux empreintes
+    static constexpr int HELLO_INTERVAL_MS = 100;
+    static constexpr int FINISH_LINGER_MS = 1000;   // --net-bot : envois après la fin
+
+signals:
+    void started(quint32 seed);
+    void desyncDetected(quint32 tick);
+    void finished();               // Fin confirmée par les deux pairs ou tickLimit atteint
+
+private slots:
+    void onReadyRead();
+    void advance();                // Un tick du FrameScheduler
+    void sendHello();
+
+private:
+    // Une entrée par tick : directions maintenues + tir
+    struct TickRecord {
+        quint32 tick = 0xFFFFFFFFu;
+        quint8 local = 0;
+        quint8 remote = 0;
+        quint8 usedRemote = 0;     // Entrée distante réellement simulée
+        bool remoteReceived = false;
+        bool ended = false;        // Partie terminée après le tick
+        quint64 hash = 0;          // Empreinte après le tick
+    };
+
+    struct PendingPacket {
+        qint64 dueNs;
+        QByteArray data;
+    };
+
+    void begin(quint32 seed);
+    void finish(quint32 endTick);
+    void processConfirmedTicks();
+    void sampleLocalInput(quint32 tick);
+    void simulateTick(quint32 tick);
+    void rollback();
+    void sendInputs();
+    void checkRemoteHash();
+    void sendDatagram(const QByteArray& data);
+    void flushOutgoing();
+    TickRecord& record(quint32 tick);
+    bool hasRemote(quint32 tick) const;
+    quint8 predictRemote() const;
+    quint32 finalTick() const;     // Nombre de ticks définitifs
+    void handlePacket(const QByteArray& data);
+
+    GameEngine* m_engine;
+    LockstepConfig m_config;
+    QUdpSocket* m_socket;
+    QTimer* m_helloTimer;
+    FrameScheduler* m_scheduler;   // Celui du moteur, détaché de GameEngine::update
+    QString m_error;
+
+    bool m_running;
+    bool m_finished;
+    int m_localPlayer;             // 0 = hôte, 1 = client
+    quint32 m_seed;
+
+    quint32 m_tick;                // Prochain tick à simuler
+    quint32 m_remoteKnown;         // Entrées distantes connues sur [0, m_remoteKnown)
+    quint32 m_localKnown;          // Entrées locales relevées sur [0, m_localKnown)
+    quint32 m_peerAck;             // Entrées locales reçues par le pair
+    quint32 m_rollbackTick;        // Plus ancien tick mal prédit, ou NO_ROLLBACK
+    quint8 m_heldInput;            // Touches locales maintenues
+    quint32 m_confirmed;           // Ticks définitifs déjà traités
+    quint32 m_endTick;
+
+    std::array<TickRecord, HISTORY> m_records;
+    std::array<EngineSnapshot, MAX_ROLLBACK + 1> m_snapshots;   // État avant chaque tick
+    std::vector<InputEvent> m_drained;
+    std::vector<InputEvent> m_deferredInput;   // Entrées locales écartées d'un retour arrière
+
+    ReplayWriter* m_recorder;
+    std::vector<WorldState> m_recordStates;   // État après chaque tick, indice tick % HISTORY
+
+    quint32 m_remoteHashTick;      // Empreinte reçue en attente de comparaison
+    quint64 m_remoteHash;
+    bool m_remoteHashPending;
+    qint64 m_lastHashChecked;      // Dernier tick comparé, -1 au départ
+
+    QElapsedTimer m_clock;
+    QRandomGenerator m_lossRandom;
+    std::deque<PendingPacket> m_outgoing;
+    LockstepStats m_stats;
+
+    static constexpr quint32 NO_ROLLBACK = 0xFFFFFFFFu;
+};
+
+#endif // LOCKSTEPSESSION_H
@@ -1,8 +1,12 @@
 #include "MenuWidget.hpp"
 #include "GameWidget.hpp"
 #include "GameEngine.hpp"
+#include "SoundManager.hpp"
+#include "LockstepSession.hpp"
+#include "ReplayFile.hpp"
 #include <QMainWindow>
 #include <QStackedWidget>
+#include <memory>
 
 class MainWindow : public QMainWindow
 {
@@ -12,6 +16,10 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow() = default;
 
+    void setCampaign(const QStringList& levelFiles);
+    bool startNetworkGame(const LockstepConfig& config);   // --host / --connect
+    bool startRecording(const QString& path);              // --record
+
 private slots:
     void onStartGame();
     void onOpenSettings();
@@ -20,4 +28,7 @@ private:
     MenuWidget* m_menu = nullptr;
     GameWidget* m_gameScene = nullptr;
     GameEngine* m_gameEngine = nullptr;
+    SoundManager* m_sound = nullptr;
+    LockstepSession* m_session = nullptr;
+    std::unique_ptr<ReplayWriter> m_replay;
 };
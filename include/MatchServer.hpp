@@ -0,0 +1,172 @@
+#ifndef MATCHSERVER_H
+#define MATCHSERVER_H
+
+#include <QCoreApplication>
+#include <QMutex>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "GameEngine.hpp"
+#include "ServerProtocol.hpp"
+#include "StateSnapshot.hpp"
+
+// Serveur de parties sans interface (Linux, epoll). Le thread principal
+// accepte les connexions et lit le message JOIN ; chaque salle appartient
+// ensuite à un seul worker (salle % workers), qui fait tourner ses moteurs
+// et ses sockets dans sa propre boucle epoll, sans verrou.
+
+struct ServerConfig {
+    quint16 port = ServerProtocol::DEFAULT_PORT;
+    int workers = 0;                    // 0 = un par cœur
+    int snapshotRate = 20;              // Instantanés par seconde
+    int playersPerRoom = 2;             // 1 ou 2 (tank partenaire)
+    int statsIntervalMs = 5000;
+    int maxSendBuffer = 256 * 1024;     // Au-delà, le client trop lent est déconnecté
+};
+
+// Compteurs d'un worker, lus par le thread principal pour les statistiques
+struct WorkerCounters {
+    std::atomic<quint64> roomTicks{0};
+    std::atomic<quint64> busyNs{0};         // Simulation, instantanés et envois
+    std::atomic<quint64> bytesSent{0};
+    std::atomic<quint64> bytesReceived{0};
+    std::atomic<quint64> snapshots{0};
+    std::atomic<quint64> lateTicks{0};      // Ticks abandonnés faute de temps
+    std::atomic<int> rooms{0};
+    std::atomic<int> clients{0};
+};
+
+struct ServerConnection {
+    int fd = -1;
+    quint32 roomId = 0;
+    quint8 player = 0;
+    bool hasBaseline = false;           // A reçu l'instantané complet
+    bool wantWrite = false;             // EPOLLOUT armé
+    QByteArray inbox;
+    QByteArray outbox;
+    int outOffset = 0;
+};
+
+// Une salle : un moteur sans FrameScheduler, ses clients et le dernier
+// état diffusé, référence du prochain delta
+class MatchRoom {
+public:
+    MatchRoom(quint32 id, quint32 seed, int capacity);
+
+    quint32 id() const { return m_id; }
+
+    int addClient(ServerConnection* client);       // Joueur attribué, -1 si pleine
+    void removeClient(ServerConnection* client);
+    bool isEmpty() const;
+    const std::vector<ServerConnection*>& clients() const { return m_clients; }
+
+    void setInput(quint8 player, quint8 mask);
+    void tick();
+
+    // Delta commun aux clients à jour ; complet seulement si needFull
+    void buildSnapshot(QByteArray& deltaFrame, QByteArray& fullFrame, bool needFull);
+
+private:
+    void restart();
+
+    quint32 m_id;
+    GameEngine m_engine;
+    std::vector<ServerConnection*> m_clients;   // Indice = joueur, nullptr = libre
+    quint8 m_masks[2];
+    quint8 m_applied[2];                        // Directions déjà transmises au moteur
+    WorldState m_sent;
+    WorldState m_current;
+    WorldState m_empty;
+    QByteArray m_encoded;
+};
+
+class ServerWorker {
+public:
+    ServerWorker(int index, const ServerConfig& config);
+    ~ServerWorker();
+
+    bool start(QString* error);
+    void stop();
+
+    // Appelé par le thread principal : la connexion change de thread
+    void adopt(int fd, quint32 roomId, quint32 seed, const QByteArray& leftover);
+
+    const WorkerCounters& counters() const { return m_counters; }
+
+private:
+    struct Handoff {
+        int fd;
+        quint32 roomId;
+        quint32 seed;
+        QByteArray leftover;
+    };
+
+    void run();
+    void wake();
+    void acceptHandoffs();
+    void onReadable(ServerConnection& connection);
+    void processFrames(ServerConnection& connection);
+    bool flush(ServerConnection& connection);       // Faux si la connexion est fermée
+    bool send(ServerConnection& connection, const QByteArray& frame);   // Idem
+    void closeConnection(int fd);
+    void tickRooms();
+    void broadcastSnapshots();
+
+    int m_index;
+    ServerConfig m_config;
+    int m_ticksPerSnapshot;
+    quint64 m_tickCounter;
+
+    int m_epoll;
+    int m_wakeFd;                       // eventfd : connexions à adopter ou arrêt
+    std::atomic<bool> m_running;
+    std::unique_ptr<QThread> m_thread;
+
+    QMutex m_handoffMutex;
+    std::vector<Handoff> m_handoffs;
+    std::vector<Handoff> m_adopting;
+
+    std::unordered_map<int, std::unique_ptr<ServerConnection>> m_connections;
+    std::unordered_map<quint32, std::unique_ptr<MatchRoom>> m_rooms;
+    QByteArray m_deltaFrame;
+    QByteArray m_fullFrame;
+    WorkerCounters m_counters;
+};
+
+class MatchServer {
+public:
+    explicit MatchServer(const ServerConfig& config);
+    ~MatchServer();
+
+    bool listen(QString* error);
+    int run();                          // Jusqu'à SIGINT ou SIGTERM
+
+    // Point d'entrée de tank_server
+    static int runFromCommandLine(const QCoreApplication& app);
+
+    static constexpr int MAX_EVENTS = 256;
+    static constexpr int MAX_PENDING_BYTES = 64;   // Avant JOIN
+
+private:
+    void acceptClients();
+    void readJoin(int fd);
+    void dropPending(int fd);
+    void printStats(qint64 intervalNs);
+
+    ServerConfig m_config;
+    int m_listenFd;
+    int m_epoll;
+    std::vector<std::unique_ptr<ServerWorker>> m_workers;
+    std::unordered_map<int, QByteArray> m_pending;  // Connexions en attente de JOIN
+
+    // Totaux au dernier affichage
+    quint64 m_lastRoomTicks;
+    quint64 m_lastBusyNs;
+    quint64 m_lastBytesSent;
+    quint64 m_lastBytesReceived;
+    quint64 m_lastSnapshots;
+};
+
+#endif // MATCHSERVER_H
@@ -0,0 +1,28 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <QtGlobal>
+
+// Noyaux de pixels pour le rendu logiciel (ARGB32 prémultiplié).
+// L'implémentation (AVX2, SSE2 ou scalaire) est choisie au premier appel
+// selon le processeur.
+namespace PixelKernels {
+
+// Remplir count pixels avec une couleur opaque
+void fillSpan(quint32* dst, int count, quint32 color);
+
+// Copier count pixels opaques (blit de tuile)
+void copySpan(quint32* dst, const quint32* src, int count);
+
+// Composer count pixels source sur la destination (source-over)
+void blendSpan(quint32* dst, const quint32* src, int count);
+
+// Composer une couleur translucide constante (voiles pause / game over)
+void blendSolidSpan(quint32* dst, int count, quint32 color);
+
+// Nom de l'implémentation active ("avx2", "sse2" ou "scalar")
+const char* activeImplementation();
+
+}
+
+#endif // PIXELKERNELS_H
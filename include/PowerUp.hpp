@@ -9,14 +9,16 @@ enum class PowerUpType {
     SHIELD
 };
 
-class PowerUp : public Entity {
+class PowerUp final : public Entity {
 public:
-    PowerUp(const QPointF& position, PowerUpType powerUpType);
+    PowerUp(const FixedPoint& position, PowerUpType powerUpType);
     
     void render(QPainter& painter) override;
     void update() override;
     
     PowerUpType getPowerUpType() const { return m_powerUpType; }
+    bool isBlinking() const { return m_lifetime < BLINK_THRESHOLD; }
+    bool isBlinkHidden() const { return isBlinking() && (m_blinkTimer / 10) % 2 == 0; }
     
 private:
     PowerUpType m_powerUpType;
@@ -25,6 +27,7 @@ private:
     
     static constexpr int POWERUP_SIZE = 24;
     static constexpr int MAX_LIFETIME = 300;
+    static constexpr int BLINK_THRESHOLD = 60;
     
     EntityType powerUpTypeToEntityType(PowerUpType type);
     QColor powerUpTypeToColor(PowerUpType type);
@@ -0,0 +1,115 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <vector>
+
+// Phases mesurées d'une frame (simulation puis rendu)
+enum class ProfilePhase {
+    TICK,               // GameEngine::update() complet
+    PLAYER_UPDATE,
+    UPDATE_ENEMIES,
+    UPDATE_BULLETS,
+    UPDATE_POWERUPS,
+    CHECK_COLLISIONS,
+    CLEANUP_INACTIVE,
+    PAINT,              // GameWidget::paintEvent
+    COUNT
+};
+
+constexpr int PROFILE_PHASE_COUNT = static_cast<int>(ProfilePhase::COUNT);
+
+// Temps cumulé par phase sur une frame
+struct FrameProfile {
+    qint64 phaseNs[PROFILE_PHASE_COUNT] = {};
+};
+
+// Temps cumulé par phase depuis le dernier resetTotals()
+struct PhaseTotals {
+    qint64 totalNs[PROFILE_PHASE_COUNT] = {};
+    quint64 calls[PROFILE_PHASE_COUNT] = {};
+};
+
+// Profileur intégré : conserve les dernières frames (temps par phase et
+// événements horodatés) pour l'overlay de GameWidget et l'export au format
+// Chrome trace_event (chrome://tracing, Perfetto).
+// Utilisé depuis le thread principal uniquement.
+class Profiler {
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    static constexpr int FRAME_HISTORY = 240;
+    static constexpr int EVENT_HISTORY = FRAME_HISTORY * 32;
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    qint64 now() const { return m_clock.nsecsElapsed(); }
+
+    void beginFrame();
+    void record(ProfilePhase phase, qint64 startNs, qint64 durationNs);
+
+    // Frames conservées, index 0 = la plus ancienne
+    int frameCount() const { return static_cast<int>(m_frames.size()); }
+    const FrameProfile& frameAt(int index) const;
+
+    const PhaseTotals& getTotals() const { return m_totals; }
+    void resetTotals() { m_totals = PhaseTotals(); }
+
+    // Écrire les frameCount dernières frames en JSON trace_event
+    bool writeChromeTrace(const QString& path, int frameCount = FRAME_HISTORY) const;
+
+    static const char* phaseName(ProfilePhase phase);
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    struct ProfileEvent {
+        ProfilePhase phase;
+        quint32 frame;
+        qint64 startNs;
+        qint64 durationNs;
+    };
+
+    bool m_enabled;
+    QElapsedTimer m_clock;
+    quint32 m_frameIndex;
+
+    std::vector<FrameProfile> m_frames;    // Tampon circulaire
+    size_t m_frameHead;
+    std::vector<ProfileEvent> m_events;    // Tampon circulaire
+    size_t m_eventHead;
+    PhaseTotals m_totals;
+};
+
+// Mesure la durée de vie du bloc courant pour une phase donnée
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase)
+        : m_phase(phase)
+        , m_start(Profiler::instance().isEnabled() ? Profiler::instance().now() : -1)
+    {
+    }
+
+    ~ProfileScope() {
+        if (m_start >= 0) {
+            Profiler& profiler = Profiler::instance();
+            profiler.record(m_phase, m_start, profiler.now() - m_start);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfilePhase m_phase;
+    qint64 m_start;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,134 @@
+#ifndef REPLAYFILE_H
+#define REPLAYFILE_H
+
+#include <QFile>
+#include <QString>
+#include "StateSnapshot.hpp"
+
+class GameEngine;
+
+// Fichier de replay (.rpl) : un enregistrement par tick, ajouté en fin de
+// fichier. Tous les KEYFRAME_INTERVAL ticks, l'état complet ; entre deux,
+// le delta SnapshotCodec depuis le tick précédent. Un index à deux niveaux
+// (table fixe dans l'en-tête, blocs ajoutés au fil de l'eau) donne l'offset
+// de chaque image clé : aller au tick t coûte deux lectures d'index, une
+// image clé et au plus KEYFRAME_INTERVAL - 1 deltas.
+//
+// Seules des zones déjà réservées sont réécrites, et le nombre de ticks
+// de l'en-tête est mis à jour en dernier : un lecteur peut projeter le
+// fichier en mémoire pendant l'enregistrement.
+namespace ReplayFormat {
+constexpr char MAGIC[4] = {'T', 'N', 'K', 'R'};
+constexpr quint32 VERSION = 1;
+constexpr int DEFAULT_KEYFRAME_INTERVAL = 60;     // Une image clé par seconde de jeu
+constexpr int INDEX_FANOUT = 1024;                // Entrées par bloc, blocs dans la table
+
+// En-tête (64 octets, petit-boutiste)
+constexpr int HEADER_SIZE = 64;
+constexpr int HEADER_VERSION = 4;
+constexpr int HEADER_INTERVAL = 8;
+constexpr int HEADER_TICK_RATE = 12;
+constexpr int HEADER_SEED = 16;
+constexpr int HEADER_TICKS = 24;                  // u32, écrit en dernier
+constexpr int HEADER_DATA_END = 32;               // u64
+
+constexpr int TOP_INDEX_OFFSET = HEADER_SIZE;     // INDEX_FANOUT offsets de blocs (u64)
+constexpr int DATA_OFFSET = TOP_INDEX_OFFSET + INDEX_FANOUT * 8;
+
+// Enregistrement : taille de la charge (u32), type (u8), charge
+constexpr int RECORD_HEADER_SIZE = 5;
+enum RecordType : quint8 {
+    RECORD_KEYFRAME = 1,
+    RECORD_DELTA = 2,
+    RECORD_INDEX = 3     // Bloc d'index : INDEX_FANOUT offsets d'images clés (u64)
+};
+}
+
+class ReplayWriter {
+public:
+    explicit ReplayWriter(int keyframeInterval = ReplayFormat::DEFAULT_KEYFRAME_INTERVAL);
+    ~ReplayWriter();
+
+    bool open(const QString& path, quint32 seed, QString* error = nullptr);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    // Un appel par tick simulé
+    bool recordTick(const GameEngine& engine);
+    bool append(const WorldState& state);
+
+    quint32 tickCount() const { return m_ticks; }
+    qint64 bytesWritten() const { return m_end; }
+    QString errorString() const { return m_error; }
+
+    // Partie d'un BotPlayer enregistrée sans interface (tank_replay record)
+    static bool recordBotMatch(const QString& path, quint32 seed, int ticks, int keyframeInterval,
+                               QString* error = nullptr);
+
+private:
+    bool appendRecord(ReplayFormat::RecordType type, const QByteArray& payload);
+    bool writeAt(qint64 offset, const char* data, int size);
+    bool fail(const QString& message);
+
+    QFile m_file;
+    int m_interval;
+    quint32 m_ticks;
+    qint64 m_end;                   // Fin des données
+    qint64 m_indexBlock;            // Charge du bloc d'index courant
+    WorldState m_previous;
+    WorldState m_empty;
+    QByteArray m_payload;
+    QByteArray m_record;
+    QString m_error;
+};
+
+// Lecture par projection en mémoire ; refresh() prend en compte les ticks
+// ajoutés depuis par un enregistrement en cours
+class ReplayReader {
+public:
+    ReplayReader();
+    ~ReplayReader();
+
+    bool open(const QString& path, QString* error = nullptr);
+    bool refresh();
+
+    quint32 tickCount() const { return m_ticks; }
+    int keyframeInterval() const { return m_interval; }
+    int tickRate() const { return m_tickRate; }
+    quint32 seed() const { return m_seed; }
+    qint64 dataSize() const { return m_dataEnd; }
+
+    // Aller à un tick : image clé la plus proche puis deltas
+    bool seek(quint32 tick);
+    // Tick suivant la dernière lecture (lecture continue d'un spectateur)
+    bool readNext();
+
+    const WorldState& state() const { return m_state; }
+    quint32 position() const { return m_next; }     // Prochain tick de readNext()
+    int lastSeekDeltas() const { return m_lastSeekDeltas; }
+
+private:
+    bool map(qint64 size);
+    // Enregistrement à offset (blocs d'index sautés) ; offset passe au suivant
+    bool readRecord(qint64& offset, ReplayFormat::RecordType& type, const char*& payload, int& size) const;
+    bool applyRecord(ReplayFormat::RecordType type, const char* payload, int size);
+    quint64 readU64(qint64 offset) const;
+
+    QFile m_file;
+    const uchar* m_data;
+    qint64 m_mapped;
+    quint32 m_ticks;
+    qint64 m_dataEnd;
+    int m_interval;
+    int m_tickRate;
+    quint32 m_seed;
+
+    qint64 m_cursor;                // Enregistrement suivant, 0 = à repositionner
+    quint32 m_next;
+    int m_lastSeekDeltas;
+    WorldState m_state;
+    WorldState m_scratch;
+    WorldState m_empty;
+};
+
+#endif // REPLAYFILE_H
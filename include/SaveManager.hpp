@@ -31,6 +31,9 @@ public:
     void setSfxVolume(int volume);
     int getSfxVolume() const;
 
+    void setSoftwareRendering(bool enabled);
+    bool getSoftwareRendering() const;
+
     void saveSettings();
     void loadSettings();
 
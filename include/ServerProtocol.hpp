@@ -0,0 +1,48 @@
+#ifndef SERVERPROTOCOL_H
+#define SERVERPROTOCOL_H
+
+#include <QByteArray>
+#include <QtEndian>
+#include "WireFormat.hpp"
+
+// Protocole TCP du serveur de parties (tank_server) : trames « longueur (u32)
+// + message », champs en petit-boutiste, premier octet = type du message.
+namespace ServerProtocol {
+constexpr quint16 DEFAULT_PORT = 7777;
+constexpr int FRAME_HEADER_SIZE = 4;
+constexpr quint32 MAX_FRAME_SIZE = 1 << 20;
+
+enum MessageType : quint8 {
+    MSG_JOIN = 1,        // Client : salle (u32), graine (u32), au premier message
+    MSG_INPUT = 2,       // Client : masque (u8), bits = InputAction, tir ponctuel
+    MSG_WELCOME = 3,     // Serveur : salle (u32), joueur (u8), ticks par instantané (u8)
+    MSG_SNAPSHOT = 4,    // Serveur : SnapshotCodec depuis l'instantané précédent
+    MSG_ROOM_FULL = 5    // Serveur : salle pleine, connexion fermée ensuite
+};
+
+constexpr int JOIN_SIZE = 1 + 4 + 4;
+constexpr int INPUT_SIZE = 1 + 1;     // Masque : WireFormat::MOVE_BITS et SHOOT_BIT
+
+// Ouvre une trame à la fin de out ; endFrame() écrit sa longueur
+inline int beginFrame(QByteArray& out, MessageType type) {
+    const int start = out.size();
+    WireFormat::appendU32(out, 0);
+    out.append(static_cast<char>(type));
+    return start;
+}
+
+inline void endFrame(QByteArray& out, int start) {
+    const quint32 length = static_cast<quint32>(out.size() - start - FRAME_HEADER_SIZE);
+    qToLittleEndian(length, out.data() + start);
+}
+
+// Longueur de la première trame complète de data, 0 si incomplète, -1 si invalide
+inline int frameLength(const char* data, int size) {
+    if (size < FRAME_HEADER_SIZE) return 0;
+    const quint32 length = WireFormat::readU32(data);
+    if (length == 0 || length > MAX_FRAME_SIZE) return -1;
+    return size - FRAME_HEADER_SIZE >= static_cast<int>(length) ? static_cast<int>(length) : 0;
+}
+}
+
+#endif // SERVERPROTOCOL_H
@@ -0,0 +1,67 @@
+#ifndef SOFTWARERENDERER_H
+#define SOFTWARERENDERER_H
+
+#include <QImage>
+#include <QHash>
+#include <QRegion>
+#include <functional>
+#include <vector>
+#include "GameEngine.hpp"
+
+// Rendu logiciel de la zone de jeu dans un framebuffer ARGB32 (prémultiplié).
+// Chaque entité est peinte une seule fois avec QPainter dans un sprite en
+// cache, puis recopiée à chaque frame par les noyaux SIMD de PixelKernels.
+// Pensé pour les machines sans GPU où l'antialiasing de QPainter coûte cher.
+class SoftwareRenderer {
+public:
+    SoftwareRenderer();
+
+    // Redessiner le terrain et les entités dans les rectangles de la région
+    void render(const GameEngine& engine, qreal alpha, const QRegion& region);
+    void clear(const QRegion& region);
+    // Voile translucide (pause, game over, niveau terminé)
+    void dim(const QRegion& region, const QColor& color);
+
+    QImage& framebuffer() { return m_framebuffer; }
+
+private:
+    struct Sprite {
+        QImage image;
+        QPoint offset;  // Décalage par rapport au point d'ancrage de l'entité
+        bool opaque;
+    };
+
+    // Sprite à recopier, dans l'ordre de peinture
+    struct DrawItem {
+        const Sprite* sprite;
+        QPoint anchor;
+    };
+
+    const Sprite& blockSprite(const Block& block);
+    const Sprite& tankSprite(const Tank& tank);
+    const Sprite& shieldSprite(int alpha);
+    const Sprite& bulletSprite(const Bullet& bullet);
+    const Sprite& powerUpSprite(const PowerUp& powerUp);
+
+    Sprite buildSprite(const QRectF& bounds, const QPointF& anchor,
+                       const std::function<void(QPainter&)>& paint) const;
+
+    // Entités touchant la zone à redessiner, rangées par case de la grille
+    void collect(const GameEngine& engine, qreal alpha, const QRect& area);
+    void addTank(const Tank& tank, qreal alpha, const QRect& area);
+    void addItem(const Sprite& sprite, const QPoint& anchor, const QRect& area);
+    QRect cellSpan(const QRect& rect) const;
+    void blit(const Sprite& sprite, const QPoint& anchor, const QRect& clip);
+    void fill(const QRect& rect, quint32 color);
+
+    QImage m_framebuffer;
+    quint32 m_background;
+    QHash<quint64, Sprite> m_sprites;
+
+    // Tampons réutilisés d'une frame à l'autre
+    std::vector<DrawItem> m_items;
+    std::vector<std::vector<int>> m_bins;    // Indices de m_items par case
+    std::vector<int> m_visible;
+};
+
+#endif // SOFTWARERENDERER_H
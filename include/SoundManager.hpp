@@ -2,9 +2,11 @@
 #define SOUNDMANAGER_HPP
 
 #include <QObject>
-#include <QHash>
-#include <QString>
-#include <QSoundEffect>
+#include <array>
+#include <memory>
+#include "GameEvent.hpp"
+
+class AudioMixer;
 
 class SoundManager : public QObject
 {
@@ -12,17 +14,31 @@ class SoundManager : public QObject
 
 public:
     explicit SoundManager(QObject* parent = nullptr);
+    ~SoundManager() override;
+
     void initialize();
-    void playSound(const QString& soundName);
+    // x : abscisse de la source dans la zone de jeu, négatif = centre
+    void playSound(GameEventType type, qreal x = -1);
+    // Lot d'événements d'un tick (GameEngine::gameEvents)
+    void onGameEvents(const GameEventList& events);
     void setEnabled(bool enabled);
     void setVolume(int volume);
 
 private:
+    // Son préchargé et sa priorité dans le pool de voix du mixeur
+    struct SoundSlot {
+        int id = -1;    // -1 : pas de son pour cet événement
+        int priority = 0;
+    };
+
     void loadSounds();
+    void applyVolume();
 
     bool m_enabled;
     int m_volume;
-    QHash<QString, QSoundEffect*> m_sounds;
+    std::unique_ptr<AudioMixer> m_mixer;
+    std::array<SoundSlot, GAME_EVENT_TYPE_COUNT> m_sounds;   // Indexé par GameEventType
+    int m_loadedSounds;
 };
 
 #endif // SOUNDMANAGER_HPP
@@ -0,0 +1,47 @@
+#ifndef STATESNAPSHOT_H
+#define STATESNAPSHOT_H
+
+#include <QByteArray>
+#include <vector>
+#include "Entity.hpp"
+
+class GameEngine;
+
+// État visible d'une entité, tel qu'envoyé aux clients du serveur
+struct EntityState {
+    quint32 id = 0;
+    quint8 type = 0;            // EntityType
+    quint8 direction = 0;
+    quint8 health = 0;
+    quint8 flags = 0;           // FLAG_*
+    qint32 x = 0;               // Coordonnées fixes 24.8
+    qint32 y = 0;
+
+    static constexpr quint8 FLAG_FROM_PLAYER = 0x01;   // Obus tiré par un joueur
+    static constexpr quint8 FLAG_PARTNER = 0x02;       // Tank du joueur 2
+};
+
+// Instantané de la partie ; entités actives triées par identifiant
+struct WorldState {
+    quint32 tick = 0;
+    quint8 state = 0;           // GameState
+    qint32 score = 0;
+    qint32 enemiesRemaining = 0;
+    std::vector<EntityState> entities;
+
+    void capture(const GameEngine& engine);
+    void clear();
+};
+
+// Compression différentielle : seules les entités apparues, disparues ou
+// modifiées depuis la référence sont écrites, champ par champ, en entiers
+// de longueur variable. Le terrain, immobile, ne coûte presque rien après
+// le premier envoi. Une référence vide donne un instantané complet.
+namespace SnapshotCodec {
+void encodeDelta(const WorldState& baseline, const WorldState& current, QByteArray& out);
+
+// out ne doit pas être baseline ; faux si les données sont tronquées ou incohérentes
+bool applyDelta(const WorldState& baseline, const char* data, int size, WorldState& out);
+}
+
+#endif // STATESNAPSHOT_H
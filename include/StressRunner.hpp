@@ -0,0 +1,51 @@
+#ifndef STRESSRUNNER_H
+#define STRESSRUNNER_H
+
+#include <QCoreApplication>
+#include <QRandomGenerator>
+#include "GameEngine.hpp"
+#include "Profiler.hpp"
+
+// Paramètres d'un monde synthétique (limites MAX_ENEMIES / ACTIVE_ENEMIES ignorées)
+struct StressConfig {
+    int enemies = 100;
+    int bullets = 1000;
+    int powerUps = 20;
+    int blockDensity = 20;   // Pourcentage de cases occupées
+    int ticks = 6000;
+    quint32 seed = 1;
+    bool parallelCollisions = true;
+};
+
+struct StressReport {
+    int ticks = 0;
+    qint64 elapsedNs = 0;     // Temps passé dans GameEngine::update()
+    PhaseTotals phases;
+    qint64 peakMemoryKb = 0;
+};
+
+// Mode --stress : construit un monde synthétique et le simule sans interface
+// pendant un nombre fixe de ticks. Les populations sont maintenues à leur
+// niveau cible entre deux ticks (hors mesure) pour garder une charge constante.
+class StressRunner {
+public:
+    explicit StressRunner(const StressConfig& config);
+
+    StressReport run();
+
+    // Point d'entrée de la ligne de commande : analyse, exécution, rapport
+    static int runFromCommandLine(const QCoreApplication& app);
+    static qint64 peakMemoryKb();
+
+private:
+    void buildWorld();
+    void replenish();
+    FixedPoint randomOpenPosition(int size);
+    bool isOpen(const FixedRect& box) const;
+
+    StressConfig m_config;
+    GameEngine m_engine;
+    QRandomGenerator m_random;
+};
+
+#endif // STRESSRUNNER_H
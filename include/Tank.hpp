@@ -6,10 +6,13 @@
 
 class Tank : public Entity {
 public:
-    Tank(const QPointF& position, EntityType type, const QColor& color, int speed);
+    Tank(const FixedPoint& position, EntityType type, const QColor& color, int speed);
 
     void update() override;
     void render(QPainter& painter) override;
+    QRectF getRenderBounds() const override;
+    void renderBody(QPainter& painter) const;
+    static void renderShield(QPainter& painter, const QPointF& center, int alpha);
 
     void move(Direction dir);
     void setMoving(Direction dir, bool moving);
@@ -21,6 +24,7 @@ public:
     void heal(int amount);
 
     bool hasShield() const { return m_shieldActive; }
+    int getShieldAlpha() const;  // Pulsation du bouclier (0-255)
     void activateShield(int duration);
 
     bool canShoot() const;
@@ -28,7 +32,7 @@ public:
 
 protected:
     Direction m_direction;
-    int m_speed;
+    qint32 m_speed;             // Unités fixes par tick
     int m_health;
     bool m_movingUp;
     bool m_movingDown;
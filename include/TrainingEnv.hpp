@@ -0,0 +1,130 @@
+#ifndef TRAININGENV_H
+#define TRAININGENV_H
+
+#include <QCoreApplication>
+#include <QSharedMemory>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include "GameEngine.hpp"
+#include "Constants.hpp"
+
+// Plans de l'observation, une case de la grille par octet (0 ou 1)
+enum class ObservationChannel {
+    BRICK,
+    STEEL,
+    WATER,
+    TREE,
+    BASE,
+    ENEMY,
+    ENEMY_BULLET,
+    PLAYER_BULLET,
+    POWERUP,
+    PLAYER,
+    COUNT
+};
+
+// Actions discrètes : déplacement éventuel, avec ou sans tir
+enum class TrainingAction : qint32 {
+    NOOP,
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT,
+    FIRE,
+    UP_FIRE,
+    DOWN_FIRE,
+    LEFT_FIRE,
+    RIGHT_FIRE,
+    COUNT
+};
+
+struct TrainingConfig {
+    int ticksPerStep = 1;       // Répétition de l'action (frame skip)
+    int maxTicks = 5 * 60 * GameConstants::SIMULATION_RATE;
+    GameTuning tuning;
+};
+
+struct StepResult {
+    float reward = 0.0f;
+    bool done = false;
+    int score = 0;
+    int ticks = 0;
+};
+
+// Mémoire partagée de --train-server, lue et écrite par un processus local.
+// L'agent écrit action (ou RESET_ACTION et seed) puis incrémente requestSeq ;
+// l'environnement écrit l'observation juste après l'en-tête, le résultat,
+// puis recopie requestSeq dans responseSeq.
+struct TrainingSharedHeader {
+    quint32 magic;              // "TNKE"
+    quint32 version;
+    quint32 channels;
+    quint32 height;
+    quint32 width;
+    quint32 observationOffset;  // Octets depuis le début du segment
+    std::atomic<quint32> requestSeq;
+    std::atomic<quint32> responseSeq;
+    qint32 action;
+    quint32 seed;
+    float reward;
+    quint32 done;
+    qint32 score;
+    quint32 ticks;
+};
+
+// Interface reset()/step() pour les agents d'apprentissage par renforcement.
+// L'observation (plans × hauteur × largeur, octets) est rastérisée
+// directement dans le tampon de l'appelant ou dans la mémoire partagée :
+// aucune structure intermédiaire n'est allouée à chaque pas.
+class TrainingEnv {
+public:
+    static constexpr int CHANNELS = static_cast<int>(ObservationChannel::COUNT);
+    static constexpr int WIDTH = GameConstants::GRID_WIDTH;
+    static constexpr int HEIGHT = GameConstants::GRID_HEIGHT;
+    static constexpr int PLANE_SIZE = WIDTH * HEIGHT;
+    static constexpr int OBSERVATION_SIZE = CHANNELS * PLANE_SIZE;
+    static constexpr qint32 RESET_ACTION = -1;
+
+    // Récompenses : score gagné / 100, vie perdue, fin de niveau
+    static constexpr float REWARD_SCORE_SCALE = 0.01f;
+    static constexpr float REWARD_HIT = -1.0f;
+    static constexpr float REWARD_WIN = 10.0f;
+    static constexpr float REWARD_LOSS = -10.0f;
+
+    explicit TrainingEnv(const TrainingConfig& config = TrainingConfig());
+    ~TrainingEnv();
+
+    // observation : OBSERVATION_SIZE octets, ou nullptr
+    void reset(quint32 seed, quint8* observation = nullptr);
+    StepResult step(TrainingAction action, quint8* observation = nullptr);
+    void writeObservation(quint8* out);
+
+    // Segment partagé créé sous cette clé, puis boucle de service
+    bool createSharedMemory(const QString& key);
+    int serve();
+    QString errorString() const { return m_error; }
+
+    // Point d'entrée --train-server <clé>
+    static int runFromCommandLine(const QCoreApplication& app);
+
+private:
+    void setMoveAction(TrainingAction action);
+    void writeTerrain();
+    quint8* sharedObservation();
+
+    TrainingConfig m_config;
+    std::unique_ptr<GameEngine> m_engine;
+    int m_ticks;
+    InputAction m_heldMove;
+    bool m_moving;
+
+    // Terrain rastérisé, recopié tel quel tant qu'aucun bloc ne disparaît
+    quint8 m_terrain[5 * PLANE_SIZE];
+    size_t m_terrainBlockCount;
+
+    QSharedMemory m_shared;
+    QString m_error;
+};
+
+#endif // TRAININGENV_H
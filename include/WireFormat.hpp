@@ -0,0 +1,46 @@
+#ifndef WIREFORMAT_H
+#define WIREFORMAT_H
+
+#include <QByteArray>
+#include <QtEndian>
+#include "InputQueue.hpp"
+
+// Champs binaires communs aux fichiers (niveaux, replays) et aux protocoles
+// réseau (lockstep, serveur) : entiers en petit-boutiste et masque d'entrées
+// d'un tick
+namespace WireFormat {
+
+// Masque d'entrées : un bit par InputAction, bits 0-3 = directions
+// maintenues, bit 4 = tir ponctuel
+constexpr quint8 actionBit(InputAction action) {
+    return static_cast<quint8>(1 << static_cast<int>(action));
+}
+constexpr quint8 MOVE_BITS = actionBit(InputAction::MOVE_UP) | actionBit(InputAction::MOVE_DOWN)
+                           | actionBit(InputAction::MOVE_LEFT) | actionBit(InputAction::MOVE_RIGHT);
+constexpr quint8 SHOOT_BIT = actionBit(InputAction::SHOOT);
+static_assert(MOVE_BITS == 0x0F && SHOOT_BIT == 0x10, "Masque d'entrées figé par les formats");
+
+// Écriture en place, dans un en-tête réservé d'avance
+template <typename T>
+inline void putLittleEndian(char* out, T value) {
+    qToLittleEndian(value, out);
+}
+
+template <typename T>
+inline void appendLittleEndian(QByteArray& out, T value) {
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, sizeof(T));
+}
+
+inline void appendU16(QByteArray& out, quint16 value) { appendLittleEndian(out, value); }
+inline void appendU32(QByteArray& out, quint32 value) { appendLittleEndian(out, value); }
+inline void appendU64(QByteArray& out, quint64 value) { appendLittleEndian(out, value); }
+
+// Lecture sans contrainte d'alignement
+inline quint16 readU16(const void* data) { return qFromLittleEndian<quint16>(data); }
+inline quint32 readU32(const void* data) { return qFromLittleEndian<quint32>(data); }
+inline quint64 readU64(const void* data) { return qFromLittleEndian<quint64>(data); }
+}
+
+#endif // WIREFORMAT_H
@@ -0,0 +1,699 @@
+#include "../include/MatchServer.hpp"
+#include "../include/Profiler.hpp"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QDebug>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+using namespace ServerProtocol;
+using namespace WireFormat;
+
+namespace {
+constexpr int WORKER_MAX_EVENTS = 256;
+constexpr int READ_CHUNK = 4096;
+constexpr qint64 TICK_NS = 1000000000LL / GameConstants::SIMULATION_RATE;
+constexpr int MAX_LATE_TICKS = 5;       // Retard au-delà duquel on ne rattrape plus
+
+volatile std::sig_atomic_t s_stopRequested = 0;
+
+void requestStop(int) {
+    s_stopRequested = 1;
+}
+
+void setNoDelay(int fd) {
+    const int enabled = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+}
+}
+
+// --- Salle ---
+
+MatchRoom::MatchRoom(quint32 id, quint32 seed, int capacity)
+    : m_id(id)
+    , m_clients(qBound(1, capacity, 2), nullptr)
+    , m_masks{0, 0}
+    , m_applied{0, 0}
+{
+    m_engine.setSeed(seed);
+    m_engine.setPlayerCount(static_cast<int>(m_clients.size()));
+    m_engine.setParallelCollisions(false);   // Les cœurs sont déjà répartis entre les workers
+    m_engine.setPreloadNextLevel(false);     // Partie finie : relancée sur place
+    restart();
+}
+
+void MatchRoom::restart() {
+    // Démarrage sans FrameScheduler : le worker cadence les ticks.
+    // Les identifiants d'entités restent uniques : le delta suivant
+    // décrit simplement un terrain tout neuf.
+    m_engine.startHeadless();
+    m_applied[0] = m_applied[1] = 0;
+}
+
+int MatchRoom::addClient(ServerConnection* client) {
+    for (size_t player = 0; player < m_clients.size(); player++) {
+        if (!m_clients[player]) {
+            m_clients[player] = client;
+            return static_cast<int>(player);
+        }
+    }
+    return -1;
+}
+
+void MatchRoom::removeClient(ServerConnection* client) {
+    for (size_t player = 0; player < m_clients.size(); player++) {
+        if (m_clients[player] == client) {
+            m_clients[player] = nullptr;
+            m_masks[player] = 0;   // Touches relâchées au prochain tick
+        }
+    }
+}
+
+bool MatchRoom::isEmpty() const {
+    for (const ServerConnection* client : m_clients) {
+        if (client) return false;
+    }
+    return true;
+}
+
+void MatchRoom::setInput(quint8 player, quint8 mask) {
+    // Un tir reçu reste en attente jusqu'au tick suivant
+    m_masks[player] = mask | (m_masks[player] & SHOOT_BIT);
+}
+
+void MatchRoom::tick() {
+    if (m_engine.getState() != GameState::PLAYING) {
+        restart();
+    }
+
+    for (quint8 player = 0; player < m_clients.size(); player++) {
+        const quint8 mask = m_masks[player];
+        const quint8 changed = (mask ^ m_applied[player]) & MOVE_BITS;
+        for (int bit = 0; bit < 4; bit++) {
+            if (changed & (1 << bit)) {
+                m_engine.submitInput(InputEvent{static_cast<InputAction>(bit), (mask & (1 << bit)) != 0, player});
+            }
+        }
+        if (mask & SHOOT_BIT) {
+            m_engine.submitInput(InputEvent{InputAction::SHOOT, true, player});
+            m_masks[player] &= ~SHOOT_BIT;
+        }
+        m_applied[player] = mask & MOVE_BITS;
+    }
+
+    m_engine.stepTick();
+}
+
+void MatchRoom::buildSnapshot(QByteArray& deltaFrame, QByteArray& fullFrame, bool needFull) {
+    m_current.capture(m_engine);
+
+    deltaFrame.clear();
+    SnapshotCodec::encodeDelta(m_sent, m_current, m_encoded);
+    int frame = beginFrame(deltaFrame, MSG_SNAPSHOT);
+    deltaFrame.append(m_encoded);
+    endFrame(deltaFrame, frame);
+
+    fullFrame.clear();
+    if (needFull) {
+        SnapshotCodec::encodeDelta(m_empty, m_current, m_encoded);
+        frame = beginFrame(fullFrame, MSG_SNAPSHOT);
+        fullFrame.append(m_encoded);
+        endFrame(fullFrame, frame);
+    }
+
+    // L'état diffusé devient la référence ; les vecteurs gardent leur capacité
+    std::swap(m_sent, m_current);
+}
+
+// --- Worker ---
+
+ServerWorker::ServerWorker(int index, const ServerConfig& config)
+    : m_index(index)
+    , m_config(config)
+    , m_ticksPerSnapshot(qMax(1, GameConstants::SIMULATION_RATE / qMax(1, config.snapshotRate)))
+    , m_tickCounter(0)
+    , m_epoll(-1)
+    , m_wakeFd(-1)
+    , m_running(false)
+{
+}
+
+ServerWorker::~ServerWorker() {
+    stop();
+    for (const auto& entry : m_connections) {
+        ::close(entry.first);
+    }
+    if (m_wakeFd >= 0) ::close(m_wakeFd);
+    if (m_epoll >= 0) ::close(m_epoll);
+}
+
+bool ServerWorker::start(QString* error) {
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll < 0 || m_wakeFd < 0) {
+        if (error) *error = QString::fromLocal8Bit(std::strerror(errno));
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeFd;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeFd, &event);
+
+    m_running = true;
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName(QString("tank_worker_%1").arg(m_index));
+    m_thread->start();
+    return true;
+}
+
+void ServerWorker::stop() {
+    if (!m_thread) return;
+    m_running = false;
+    wake();
+    m_thread->wait();
+    m_thread.reset();
+}
+
+void ServerWorker::wake() {
+    // Un échec signifie un compteur déjà non nul : le réveil est acquis
+    const quint64 one = 1;
+    const ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(written);
+}
+
+void ServerWorker::adopt(int fd, quint32 roomId, quint32 seed, const QByteArray& leftover) {
+    {
+        QMutexLocker locker(&m_handoffMutex);
+        m_handoffs.push_back(Handoff{fd, roomId, seed, leftover});
+    }
+    wake();
+}
+
+void ServerWorker::run() {
+    QElapsedTimer clock;
+    clock.start();
+    qint64 nextTick = TICK_NS;
+    epoll_event events[WORKER_MAX_EVENTS];
+
+    while (m_running) {
+        const qint64 wait = nextTick - clock.nsecsElapsed();
+        const int timeoutMs = wait > 0 ? static_cast<int>((wait + 999999) / 1000000) : 0;
+        const int count = epoll_wait(m_epoll, events, WORKER_MAX_EVENTS, timeoutMs);
+
+        for (int i = 0; i < count; i++) {
+            const int fd = events[i].data.fd;
+            if (fd == m_wakeFd) {
+                quint64 value;
+                const ssize_t drained = ::read(m_wakeFd, &value, sizeof(value));
+                Q_UNUSED(drained);
+                acceptHandoffs();
+                continue;
+            }
+
+            // La connexion a pu être fermée plus tôt dans ce lot
+            auto it = m_connections.find(fd);
+            if (it == m_connections.end()) continue;
+            ServerConnection& connection = *it->second;
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(fd);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flush(connection)) continue;
+            if (events[i].events & EPOLLIN) onReadable(connection);
+        }
+
+        const qint64 now = clock.nsecsElapsed();
+        if (now >= nextTick) {
+            tickRooms();
+            nextTick += TICK_NS;
+            if (now - nextTick > MAX_LATE_TICKS * TICK_NS) {
+                // Surcharge : on repart de maintenant plutôt que d'enchaîner les ticks
+                m_counters.lateTicks += static_cast<quint64>((now - nextTick) / TICK_NS);
+                nextTick = now + TICK_NS;
+            }
+        }
+    }
+}
+
+void ServerWorker::acceptHandoffs() {
+    {
+        QMutexLocker locker(&m_handoffMutex);
+        m_adopting.swap(m_handoffs);
+    }
+
+    for (Handoff& handoff : m_adopting) {
+        std::unique_ptr<MatchRoom>& room = m_rooms[handoff.roomId];
+        if (!room) {
+            room = std::make_unique<MatchRoom>(handoff.roomId, handoff.seed, m_config.playersPerRoom);
+            m_counters.rooms++;
+        }
+
+        auto connection = std::make_unique<ServerConnection>();
+        connection->fd = handoff.fd;
+        connection->roomId = handoff.roomId;
+        const int player = room->addClient(connection.get());
+        if (player < 0) {
+            QByteArray frame;
+            endFrame(frame, beginFrame(frame, MSG_ROOM_FULL));
+            ::send(handoff.fd, frame.constData(), frame.size(), MSG_NOSIGNAL);
+            ::close(handoff.fd);
+            continue;
+        }
+        connection->player = static_cast<quint8>(player);
+        connection->inbox = handoff.leftover;
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = handoff.fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, handoff.fd, &event);
+
+        ServerConnection& added = *connection;
+        m_connections[handoff.fd] = std::move(connection);
+        m_counters.clients++;
+
+        QByteArray welcome;
+        const int frame = beginFrame(welcome, MSG_WELCOME);
+        appendU32(welcome, handoff.roomId);
+        welcome.append(static_cast<char>(player));
+        welcome.append(static_cast<char>(m_ticksPerSnapshot));
+        endFrame(welcome, frame);
+        if (send(added, welcome)) {
+            processFrames(added);
+        }
+    }
+    m_adopting.clear();
+}
+
+void ServerWorker::onReadable(ServerConnection& connection) {
+    char buffer[READ_CHUNK];
+    for (;;) {
+        const ssize_t received = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.inbox.append(buffer, static_cast<int>(received));
+            m_counters.bytesReceived += static_cast<quint64>(received);
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (received < 0 && errno == EINTR) continue;
+        closeConnection(connection.fd);   // Fermée par le client ou erreur
+        return;
+    }
+    processFrames(connection);
+}
+
+void ServerWorker::processFrames(ServerConnection& connection) {
+    const char* data = connection.inbox.constData();
+    const int size = connection.inbox.size();
+    int offset = 0;
+
+    for (;;) {
+        const int length = frameLength(data + offset, size - offset);
+        if (length == 0) break;
+        if (length < 0) {
+            closeConnection(connection.fd);
+            return;
+        }
+
+        const char* message = data + offset + FRAME_HEADER_SIZE;
+        if (static_cast<quint8>(message[0]) == MSG_INPUT && length >= INPUT_SIZE) {
+            m_rooms[connection.roomId]->setInput(connection.player, static_cast<quint8>(message[1]));
+        }
+        offset += FRAME_HEADER_SIZE + length;
+    }
+
+    if (offset > 0) {
+        connection.inbox.remove(0, offset);
+    }
+}
+
+bool ServerWorker::send(ServerConnection& connection, const QByteArray& frame) {
+    connection.outbox.append(frame);
+    if (connection.outbox.size() - connection.outOffset > m_config.maxSendBuffer) {
+        qWarning() << "Client trop lent, déconnecté : salle" << connection.roomId;
+        closeConnection(connection.fd);
+        return false;
+    }
+    return flush(connection);
+}
+
+bool ServerWorker::flush(ServerConnection& connection) {
+    while (connection.outOffset < connection.outbox.size()) {
+        const ssize_t sent = ::send(connection.fd, connection.outbox.constData() + connection.outOffset,
+                                    connection.outbox.size() - connection.outOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outOffset += static_cast<int>(sent);
+            m_counters.bytesSent += static_cast<quint64>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Tampon du noyau plein : on attend EPOLLOUT
+            if (!connection.wantWrite) {
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT;
+                event.data.fd = connection.fd;
+                epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+                connection.wantWrite = true;
+            }
+            return true;
+        }
+        closeConnection(connection.fd);
+        return false;
+    }
+
+    connection.outbox.clear();
+    connection.outOffset = 0;
+    if (connection.wantWrite) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = connection.fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.wantWrite = false;
+    }
+    return true;
+}
+
+void ServerWorker::closeConnection(int fd) {
+    auto it = m_connections.find(fd);
+    if (it == m_connections.end()) return;
+
+    const quint32 roomId = it->second->roomId;
+    auto room = m_rooms.find(roomId);
+    if (room != m_rooms.end()) {
+        room->second->removeClient(it->second.get());
+        if (room->second->isEmpty()) {
+            m_rooms.erase(room);
+            m_counters.rooms--;
+        }
+    }
+
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    m_connections.erase(it);
+    m_counters.clients--;
+}
+
+void ServerWorker::tickRooms() {
+    QElapsedTimer timer;
+    timer.start();
+
+    for (auto& entry : m_rooms) {
+        entry.second->tick();
+    }
+    m_counters.roomTicks += m_rooms.size();
+
+    m_tickCounter++;
+    if (m_tickCounter % m_ticksPerSnapshot == 0) {
+        broadcastSnapshots();
+    }
+
+    m_counters.busyNs += static_cast<quint64>(timer.nsecsElapsed());
+}
+
+void ServerWorker::broadcastSnapshots() {
+    // Les fermetures pendant l'envoi retirent des salles : on copie les clés
+    std::vector<quint32> roomIds;
+    roomIds.reserve(m_rooms.size());
+    for (const auto& entry : m_rooms) {
+        roomIds.push_back(entry.first);
+    }
+
+    std::vector<int> recipients;
+    for (quint32 roomId : roomIds) {
+        auto it = m_rooms.find(roomId);
+        if (it == m_rooms.end()) continue;
+        MatchRoom& room = *it->second;
+
+        bool needFull = false;
+        recipients.clear();
+        for (ServerConnection* client : room.clients()) {
+            if (!client) continue;
+            needFull = needFull || !client->hasBaseline;
+            recipients.push_back(client->fd);
+        }
+
+        room.buildSnapshot(m_deltaFrame, m_fullFrame, needFull);
+        for (int fd : recipients) {
+            auto connection = m_connections.find(fd);
+            if (connection == m_connections.end()) continue;
+            ServerConnection& client = *connection->second;
+            // send() peut fermer la connexion : client n'est plus valide après un échec
+            if (!send(client, client.hasBaseline ? m_deltaFrame : m_fullFrame)) continue;
+            client.hasBaseline = true;
+            m_counters.snapshots++;
+        }
+    }
+}
+
+// --- Thread principal : acceptation ---
+
+MatchServer::MatchServer(const ServerConfig& config)
+    : m_config(config)
+    , m_listenFd(-1)
+    , m_epoll(-1)
+    , m_lastRoomTicks(0)
+    , m_lastBusyNs(0)
+    , m_lastBytesSent(0)
+    , m_lastBytesReceived(0)
+    , m_lastSnapshots(0)
+{
+    const int workers = config.workers > 0 ? config.workers : QThread::idealThreadCount();
+    for (int i = 0; i < workers; i++) {
+        m_workers.push_back(std::make_unique<ServerWorker>(i, config));
+    }
+}
+
+MatchServer::~MatchServer() {
+    m_workers.clear();
+    for (const auto& entry : m_pending) {
+        ::close(entry.first);
+    }
+    if (m_listenFd >= 0) ::close(m_listenFd);
+    if (m_epoll >= 0) ::close(m_epoll);
+}
+
+bool MatchServer::listen(QString* error) {
+    auto fail = [error]() {
+        if (error) *error = QString::fromLocal8Bit(std::strerror(errno));
+        return false;
+    };
+
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) return fail();
+    const int reuse = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(m_config.port);
+    if (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) return fail();
+    if (::listen(m_listenFd, SOMAXCONN) < 0) return fail();
+
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll < 0) return fail();
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_listenFd;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listenFd, &event);
+
+    for (const auto& worker : m_workers) {
+        if (!worker->start(error)) return false;
+    }
+    return true;
+}
+
+int MatchServer::run() {
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    QElapsedTimer clock;
+    clock.start();
+    qint64 lastStats = 0;
+    epoll_event events[MAX_EVENTS];
+
+    while (!s_stopRequested) {
+        const int count = epoll_wait(m_epoll, events, MAX_EVENTS, 100);
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.fd == m_listenFd) {
+                acceptClients();
+            } else {
+                readJoin(events[i].data.fd);
+            }
+        }
+
+        const qint64 now = clock.nsecsElapsed();
+        if (m_config.statsIntervalMs > 0 && now - lastStats >= m_config.statsIntervalMs * 1000000LL) {
+            printStats(now - lastStats);
+            lastStats = now;
+        }
+    }
+
+    for (const auto& worker : m_workers) {
+        worker->stop();
+    }
+    return 0;
+}
+
+void MatchServer::acceptClients() {
+    for (;;) {
+        const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;   // EAGAIN : file d'attente vide ; autre erreur : réessai au prochain réveil
+        }
+        setNoDelay(fd);
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event);
+        m_pending[fd] = QByteArray();
+    }
+}
+
+void MatchServer::readJoin(int fd) {
+    auto it = m_pending.find(fd);
+    if (it == m_pending.end()) return;
+    QByteArray& inbox = it->second;
+
+    char buffer[MAX_PENDING_BYTES];
+    for (;;) {
+        const ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            inbox.append(buffer, static_cast<int>(received));
+            if (inbox.size() > MAX_PENDING_BYTES * 4) break;
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (received < 0 && errno == EINTR) continue;
+        dropPending(fd);
+        return;
+    }
+
+    const int length = frameLength(inbox.constData(), inbox.size());
+    if (length == 0 && inbox.size() <= MAX_PENDING_BYTES) return;   // JOIN incomplet
+    const char* message = inbox.constData() + FRAME_HEADER_SIZE;
+    if (length < JOIN_SIZE || static_cast<quint8>(message[0]) != MSG_JOIN) {
+        dropPending(fd);
+        return;
+    }
+
+    const quint32 roomId = readU32(message + 1);
+    const quint32 seed = readU32(message + 5);
+    const QByteArray leftover = inbox.mid(FRAME_HEADER_SIZE + length);
+
+    // La salle, et donc ses clients, appartiennent à un seul worker
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    m_pending.erase(it);
+    m_workers[roomId % m_workers.size()]->adopt(fd, roomId, seed, leftover);
+}
+
+void MatchServer::dropPending(int fd) {
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    m_pending.erase(fd);
+}
+
+void MatchServer::printStats(qint64 intervalNs) {
+    quint64 roomTicks = 0;
+    quint64 busyNs = 0;
+    quint64 bytesSent = 0;
+    quint64 bytesReceived = 0;
+    quint64 snapshots = 0;
+    quint64 lateTicks = 0;
+    int rooms = 0;
+    int clients = 0;
+    for (const auto& worker : m_workers) {
+        const WorkerCounters& counters = worker->counters();
+        roomTicks += counters.roomTicks;
+        busyNs += counters.busyNs;
+        bytesSent += counters.bytesSent;
+        bytesReceived += counters.bytesReceived;
+        snapshots += counters.snapshots;
+        lateTicks += counters.lateTicks;
+        rooms += counters.rooms;
+        clients += counters.clients;
+    }
+
+    const quint64 ticks = roomTicks - m_lastRoomTicks;
+    const quint64 busy = busyNs - m_lastBusyNs;
+    const double seconds = intervalNs / 1e9;
+    const double roomSeconds = ticks / static_cast<double>(GameConstants::SIMULATION_RATE);
+
+    // Salles qu'un cœur tiendrait à 60 ticks/s au coût mesuré par salle
+    const double roomTickNs = ticks > 0 ? static_cast<double>(busy) / ticks : 0.0;
+    const double roomsPerCore = roomTickNs > 0 ? TICK_NS / roomTickNs : 0.0;
+
+    QTextStream out(stdout);
+    out << "server_stats workers=" << m_workers.size() << " rooms=" << rooms << " clients=" << clients
+        << " room_tick_us=" << roomTickNs / 1000.0 << " rooms_per_core=" << static_cast<qint64>(roomsPerCore)
+        << " cpu_busy=" << (seconds > 0 ? busy / (intervalNs * static_cast<double>(m_workers.size())) : 0.0)
+        << " snapshots_per_s=" << (snapshots - m_lastSnapshots) / seconds
+        << " bytes_out_per_room_s=" << (roomSeconds > 0 ? (bytesSent - m_lastBytesSent) / roomSeconds : 0.0)
+        << " bytes_in_per_room_s=" << (roomSeconds > 0 ? (bytesReceived - m_lastBytesReceived) / roomSeconds : 0.0)
+        << " late_ticks=" << lateTicks << "\n";
+    out.flush();
+
+    m_lastRoomTicks = roomTicks;
+    m_lastBusyNs = busyNs;
+    m_lastBytesSent = bytesSent;
+    m_lastBytesReceived = bytesReceived;
+    m_lastSnapshots = snapshots;
+}
+
+int MatchServer::runFromCommandLine(const QCoreApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Serveur de parties Tank Battle");
+    parser.addHelpOption();
+
+    const ServerConfig defaults;
+    const QCommandLineOption portOption("port", "Port TCP d'écoute.", "port", QString::number(defaults.port));
+    const QCommandLineOption workersOption("workers", "Threads de simulation (0 = un par cœur).", "n", "0");
+    const QCommandLineOption rateOption("snapshot-rate", "Instantanés envoyés par seconde.", "hz",
+                                        QString::number(defaults.snapshotRate));
+    const QCommandLineOption playersOption("players-per-room", "Joueurs par salle (1 ou 2).", "n",
+                                           QString::number(defaults.playersPerRoom));
+    const QCommandLineOption statsOption("stats-interval", "Intervalle des statistiques en ms (0 = aucune).", "ms",
+                                         QString::number(defaults.statsIntervalMs));
+    for (const auto& option : {portOption, workersOption, rateOption, playersOption, statsOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    ServerConfig config;
+    config.port = static_cast<quint16>(parser.value(portOption).toUInt());
+    config.workers = qMax(0, parser.value(workersOption).toInt());
+    config.snapshotRate = qBound(1, parser.value(rateOption).toInt(), GameConstants::SIMULATION_RATE);
+    config.playersPerRoom = qBound(1, parser.value(playersOption).toInt(), 2);
+    config.statsIntervalMs = qMax(0, parser.value(statsOption).toInt());
+
+    // Comme --batch : pas de journal par tick ni de profileur, partagé entre threads
+    QLoggingCategory::setFilterRules("*.debug=false");
+    Profiler::instance().setEnabled(false);
+
+    MatchServer server(config);
+    QString error;
+    if (!server.listen(&error)) {
+        qWarning() << "Serveur indisponible sur le port" << config.port << "-" << error;
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << "tank_server port=" << config.port << " workers=" << server.m_workers.size()
+        << " snapshot_rate=" << config.snapshotRate << " players_per_room=" << config.playersPerRoom << "\n";
+    out.flush();
+    return server.run();
+}
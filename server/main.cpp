@@ -0,0 +1,16 @@
+// tank_server : serveur de parties sans interface (Linux)
+//
+//   tank_server --port 7777 --workers 4 --snapshot-rate 20
+//
+// Chaque client ouvre une connexion TCP, envoie JOIN (salle, graine) puis
+// ses entrées ; il reçoit des instantanés compressés en delta. Charge de
+// test locale : tank_loadgen.
+
+#include <QCoreApplication>
+#include "../include/MatchServer.hpp"
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("tank_server");
+    return MatchServer::runFromCommandLine(app);
+}
@@ -0,0 +1,331 @@
+#include "../include/AudioMixer.hpp"
+#include <QAudioSink>
+#include <QMediaDevices>
+#include <QAudioDevice>
+#include <QFile>
+#include <QtEndian>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr int OUTPUT_CHANNELS = 2;
+constexpr int PREFERRED_SAMPLE_RATE = 48000;
+
+// Lecture d'un entier little-endian dans un fragment du fichier WAV
+template <typename T>
+T readLittle(const char* data) {
+    return qFromLittleEndian<T>(reinterpret_cast<const uchar*>(data));
+}
+
+float decodeSample(const char* data, int bits, bool isFloat) {
+    if (isFloat) {
+        const quint32 raw = readLittle<quint32>(data);
+        float value;
+        std::memcpy(&value, &raw, sizeof(value));
+        return value;
+    }
+    switch (bits) {
+        case 8: return (static_cast<quint8>(data[0]) - 128) / 128.0f;
+        case 16: return readLittle<qint16>(data) / 32768.0f;
+        case 24: {
+            const qint32 value = (static_cast<quint8>(data[0]) << 8)
+                               | (static_cast<quint8>(data[1]) << 16)
+                               | (static_cast<quint8>(data[2]) << 24);
+            return (value >> 8) / 8388608.0f;
+        }
+        default: return 0.0f;
+    }
+}
+}
+
+AudioMixer::AudioMixer()
+    : m_sink(nullptr)
+    , m_commandHead(0)
+    , m_commandTail(0)
+    , m_masterGain(1.0f)
+    , m_droppedCommands(0)
+    , m_stolenVoices(0)
+{
+    m_thread.setObjectName("AudioMixer");
+    m_format.setSampleRate(PREFERRED_SAMPLE_RATE);
+    m_format.setChannelCount(OUTPUT_CHANNELS);
+    m_format.setSampleFormat(QAudioFormat::Int16);
+
+    // Garder le PCM 16 bits stéréo, seule la fréquence suit le périphérique
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (!device.isNull() && !device.isFormatSupported(m_format)) {
+        m_format.setSampleRate(device.preferredFormat().sampleRate());
+    }
+}
+
+AudioMixer::~AudioMixer() {
+    stop();
+}
+
+int AudioMixer::loadWav(const QString& path) {
+    if (isRunning()) {
+        qWarning() << "AudioMixer: chargement impossible pendant la lecture:" << path;
+        return -1;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Son introuvable:" << path;
+        return -1;
+    }
+
+    std::vector<float> samples;
+    QString error;
+    if (!decodeWav(file.readAll(), m_format.sampleRate(), samples, &error)) {
+        qWarning() << "Son illisible:" << path << "-" << error;
+        return -1;
+    }
+
+    m_sounds.push_back(std::move(samples));
+    return static_cast<int>(m_sounds.size()) - 1;
+}
+
+void AudioMixer::start() {
+    if (isRunning()) return;
+
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (device.isNull()) {
+        qWarning() << "AudioMixer: aucune sortie audio";
+        return;
+    }
+
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    moveToThread(&m_thread);
+    m_thread.start(QThread::TimeCriticalPriority);
+
+    // La sortie vit dans le thread du mixeur : readData() y est appelé
+    QMetaObject::invokeMethod(this, [this, device]() {
+        m_sink = new QAudioSink(device, m_format);
+        m_sink->setBufferSize(m_format.bytesForFrames(PERIOD_FRAMES * BUFFER_PERIODS));
+        m_sink->start(this);
+    }, Qt::BlockingQueuedConnection);
+
+    qDebug() << "Mixeur audio:" << device.description() << m_format.sampleRate() << "Hz,"
+             << m_sink->bufferSize() << "octets de tampon -" << m_sounds.size() << "sons";
+}
+
+void AudioMixer::stop() {
+    if (!isRunning()) return;
+
+    // Le mixeur revient au thread appelant pour pouvoir être redémarré
+    QThread* caller = QThread::currentThread();
+    QMetaObject::invokeMethod(this, [this, caller]() {
+        m_sink->stop();
+        delete m_sink;
+        m_sink = nullptr;
+        moveToThread(caller);
+    }, Qt::BlockingQueuedConnection);
+
+    m_thread.quit();
+    m_thread.wait();
+    close();
+
+    qDebug() << "Mixeur audio arrêté - voix volées:" << m_stolenVoices
+             << "| commandes perdues:" << m_droppedCommands;
+}
+
+void AudioMixer::play(int soundId, float gain, float pan, int priority) {
+    if (soundId < 0 || soundId >= static_cast<int>(m_sounds.size())) return;
+
+    const quint32 head = m_commandHead.load(std::memory_order_relaxed);
+    const quint32 tail = m_commandTail.load(std::memory_order_acquire);
+    if (head - tail >= static_cast<quint32>(COMMAND_QUEUE_SIZE)) {
+        return;   // File pleine : le mixeur a décroché, le son est perdu
+    }
+
+    m_commands[head % COMMAND_QUEUE_SIZE] = PlayCommand{soundId, gain, qBound(-1.0f, pan, 1.0f), priority};
+    m_commandHead.store(head + 1, std::memory_order_release);
+}
+
+qint64 AudioMixer::bytesAvailable() const {
+    // Flux infini : le silence est aussi une donnée à jouer
+    return m_format.bytesForFrames(PERIOD_FRAMES) + QIODevice::bytesAvailable();
+}
+
+qint64 AudioMixer::readData(char* data, qint64 maxSize) {
+    drainCommands();
+
+    const qint64 frameBytes = OUTPUT_CHANNELS * sizeof(qint16);
+    qint16* out = reinterpret_cast<qint16*>(data);
+    qint64 frames = maxSize / frameBytes;
+
+    while (frames > 0) {
+        const int chunk = static_cast<int>(qMin<qint64>(frames, PERIOD_FRAMES));
+        mix(out, chunk);
+        out += chunk * OUTPUT_CHANNELS;
+        frames -= chunk;
+    }
+
+    return (maxSize / frameBytes) * frameBytes;
+}
+
+qint64 AudioMixer::writeData(const char*, qint64) {
+    return -1;
+}
+
+void AudioMixer::drainCommands() {
+    const quint32 head = m_commandHead.load(std::memory_order_acquire);
+    quint32 tail = m_commandTail.load(std::memory_order_relaxed);
+
+    while (tail != head) {
+        startVoice(m_commands[tail % COMMAND_QUEUE_SIZE]);
+        tail++;
+    }
+    m_commandTail.store(tail, std::memory_order_release);
+}
+
+void AudioMixer::startVoice(const PlayCommand& command) {
+    Voice* target = nullptr;
+    for (Voice& voice : m_voices) {
+        if (!voice.samples) {
+            target = &voice;
+            break;
+        }
+    }
+
+    if (!target) {
+        // Pool plein : voler la voix la moins prioritaire, et à priorité
+        // égale celle qui est la plus proche de sa fin
+        Voice* victim = &m_voices[0];
+        for (Voice& voice : m_voices) {
+            const size_t remaining = voice.samples->size() - voice.position;
+            const size_t victimRemaining = victim->samples->size() - victim->position;
+            if (voice.priority < victim->priority
+                || (voice.priority == victim->priority && remaining < victimRemaining)) {
+                victim = &voice;
+            }
+        }
+        if (victim->priority > command.priority) {
+            m_droppedCommands++;
+            return;
+        }
+        target = victim;
+        m_stolenVoices++;
+    }
+
+    // Panoramique à puissance constante
+    const float angle = (command.pan + 1.0f) * static_cast<float>(M_PI) / 4.0f;
+    target->samples = &m_sounds[command.soundId];
+    target->position = 0;
+    target->gainLeft = command.gain * qCos(angle);
+    target->gainRight = command.gain * qSin(angle);
+    target->priority = command.priority;
+}
+
+void AudioMixer::mix(qint16* out, int frames) {
+    float* accumulator = m_accumulator.data();
+    std::fill(accumulator, accumulator + frames * OUTPUT_CHANNELS, 0.0f);
+
+    for (Voice& voice : m_voices) {
+        if (!voice.samples) continue;
+
+        const std::vector<float>& samples = *voice.samples;
+        const int count = static_cast<int>(qMin<size_t>(frames, samples.size() - voice.position));
+        const float* source = samples.data() + voice.position;
+
+        for (int i = 0; i < count; i++) {
+            accumulator[i * 2] += source[i] * voice.gainLeft;
+            accumulator[i * 2 + 1] += source[i] * voice.gainRight;
+        }
+
+        voice.position += count;
+        if (voice.position >= samples.size()) {
+            voice.samples = nullptr;
+        }
+    }
+
+    const float master = m_masterGain.load(std::memory_order_relaxed) * 32767.0f;
+    for (int i = 0; i < frames * OUTPUT_CHANNELS; i++) {
+        out[i] = static_cast<qint16>(qBound(-32767.0f, accumulator[i] * master, 32767.0f));
+    }
+}
+
+bool AudioMixer::decodeWav(const QByteArray& data, int targetRate, std::vector<float>& samples,
+                           QString* error) {
+    auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    if (data.size() < 12 || std::memcmp(data.constData(), "RIFF", 4) != 0
+        || std::memcmp(data.constData() + 8, "WAVE", 4) != 0) {
+        return fail("en-tête RIFF/WAVE absent");
+    }
+
+    int formatTag = 0;
+    int channels = 0;
+    int sourceRate = 0;
+    int bits = 0;
+    const char* pcm = nullptr;
+    qint64 pcmSize = 0;
+
+    // Parcours des fragments : seuls "fmt " et "data" nous intéressent
+    qint64 offset = 12;
+    while (offset + 8 <= data.size()) {
+        const char* chunk = data.constData() + offset;
+        const qint64 chunkSize = readLittle<quint32>(chunk + 4);
+        const qint64 available = qMin<qint64>(chunkSize, data.size() - offset - 8);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            formatTag = readLittle<quint16>(chunk + 8);
+            channels = readLittle<quint16>(chunk + 10);
+            sourceRate = static_cast<int>(readLittle<quint32>(chunk + 12));
+            bits = readLittle<quint16>(chunk + 22);
+            // WAVE_FORMAT_EXTENSIBLE : le vrai format est dans le sous-type
+            if (formatTag == 0xFFFE && available >= 26) {
+                formatTag = readLittle<quint16>(chunk + 32);
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            pcm = chunk + 8;
+            pcmSize = available;
+        }
+
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    const bool isFloat = formatTag == 3 && bits == 32;
+    if (!pcm || channels <= 0 || sourceRate <= 0) {
+        return fail("fragments fmt/data manquants");
+    }
+    if (!isFloat && (formatTag != 1 || (bits != 8 && bits != 16 && bits != 24))) {
+        return fail(QString("format non pris en charge (%1, %2 bits)").arg(formatTag).arg(bits));
+    }
+
+    // Mixage en mono
+    const int sampleBytes = bits / 8;
+    const qint64 frameCount = pcmSize / (sampleBytes * channels);
+    std::vector<float> mono(frameCount);
+    for (qint64 frame = 0; frame < frameCount; frame++) {
+        const char* source = pcm + frame * sampleBytes * channels;
+        float sum = 0.0f;
+        for (int channel = 0; channel < channels; channel++) {
+            sum += decodeSample(source + channel * sampleBytes, bits, isFloat);
+        }
+        mono[frame] = sum / channels;
+    }
+
+    if (sourceRate == targetRate || frameCount < 2) {
+        samples = std::move(mono);
+        return true;
+    }
+
+    // Rééchantillonnage linéaire, fait une fois au chargement
+    const double step = static_cast<double>(sourceRate) / targetRate;
+    const qint64 outputCount = static_cast<qint64>((frameCount - 1) / step) + 1;
+    samples.resize(outputCount);
+    for (qint64 i = 0; i < outputCount; i++) {
+        const double position = i * step;
+        const qint64 index = static_cast<qint64>(position);
+        const float fraction = static_cast<float>(position - index);
+        const float next = index + 1 < frameCount ? mono[index + 1] : mono[index];
+        samples[i] = mono[index] + (next - mono[index]) * fraction;
+    }
+    return true;
+}
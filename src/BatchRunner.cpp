@@ -0,0 +1,192 @@
+#include "../include/BatchRunner.hpp"
+#include "../include/BotPlayer.hpp"
+#include "../include/Profiler.hpp"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QtMath>
+#include <algorithm>
+
+namespace {
+// Valeur au rang p (0-100) d'une série triée
+int percentile(const std::vector<int>& sorted, int p) {
+    if (sorted.empty()) return 0;
+    const size_t index = std::min(sorted.size() - 1, sorted.size() * p / 100);
+    return sorted[index];
+}
+}
+
+void BatchReport::add(const MatchResult& result) {
+    matches++;
+    switch (result.outcome) {
+        case MatchOutcome::WIN: wins++; break;
+        case MatchOutcome::LOSS: losses++; break;
+        case MatchOutcome::TIMEOUT: timeouts++; break;
+    }
+    ticks += result.ticks;
+    scores.push_back(result.score);
+    durations.push_back(result.ticks);
+}
+
+void BatchReport::merge(const BatchReport& other) {
+    matches += other.matches;
+    wins += other.wins;
+    losses += other.losses;
+    timeouts += other.timeouts;
+    ticks += other.ticks;
+    scores.insert(scores.end(), other.scores.begin(), other.scores.end());
+    durations.insert(durations.end(), other.durations.begin(), other.durations.end());
+}
+
+BatchRunner::BatchRunner(const BatchConfig& config)
+    : m_config(config)
+{
+}
+
+quint32 BatchRunner::matchSeed(quint32 batchSeed, int match) {
+    // Graines décorrélées mais fixées par l'indice : le résultat ne dépend
+    // pas de l'ordre d'exécution des threads
+    quint32 value = batchSeed ^ (static_cast<quint32>(match) * 0x9E3779B9u);
+    value ^= value >> 16;
+    value *= 0x85EBCA6Bu;
+    value ^= value >> 13;
+    return value;
+}
+
+MatchResult BatchRunner::playMatch(quint32 seed, const BatchConfig& config) {
+    GameEngine engine;
+    engine.setSeed(seed);
+    engine.setTuning(config.tuning);
+    engine.setParallelCollisions(false);   // Les parties occupent déjà tous les cœurs
+    engine.setPreloadNextLevel(false);     // Partie finie au premier niveau gagné
+
+    // Démarrage sans FrameScheduler : la boucle ci-dessous cadence les ticks
+    engine.startHeadless();
+
+    BotPlayer bot(seed);
+    int tick = 0;
+    while (engine.getState() == GameState::PLAYING && tick < config.maxTicks) {
+        bot.think(engine);
+        engine.stepTick();
+        tick++;
+    }
+
+    MatchResult result;
+    result.ticks = tick;
+    result.score = engine.getScore();
+    switch (engine.getState()) {
+        case GameState::LEVEL_COMPLETE: result.outcome = MatchOutcome::WIN; break;
+        case GameState::GAME_OVER: result.outcome = MatchOutcome::LOSS; break;
+        default: result.outcome = MatchOutcome::TIMEOUT; break;
+    }
+    return result;
+}
+
+BatchReport BatchRunner::run() {
+    // Le profileur est un singleton du thread principal
+    Profiler::instance().setEnabled(false);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_config.threads > 0 ? m_config.threads : QThread::idealThreadCount());
+
+    std::vector<int> tasks;
+    for (int first = 0; first < m_config.matches; first += MATCHES_PER_TASK) {
+        tasks.push_back(first);
+    }
+
+    const BatchConfig config = m_config;
+    auto simulate = [config](int first) {
+        BatchReport partial;
+        const int last = std::min(first + MATCHES_PER_TASK, config.matches);
+        for (int match = first; match < last; match++) {
+            partial.add(playMatch(matchSeed(config.seed, match), config));
+        }
+        return partial;
+    };
+    auto reduce = [](BatchReport& total, const BatchReport& partial) {
+        total.merge(partial);
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    BatchReport report = QtConcurrent::blockingMappedReduced<BatchReport>(
+        &pool, tasks, simulate, reduce, QtConcurrent::UnorderedReduce);
+    report.elapsedNs = timer.nsecsElapsed();
+
+    std::sort(report.scores.begin(), report.scores.end());
+    std::sort(report.durations.begin(), report.durations.end());
+    return report;
+}
+
+int BatchRunner::runFromCommandLine(const QCoreApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Parties simulées en lot, sans interface");
+    parser.addHelpOption();
+
+    const QCommandLineOption batchOption("batch", "Lancer la série de parties.");
+    const QCommandLineOption matchesOption("matches", "Nombre de parties.", "n", "1000");
+    const QCommandLineOption maxTicksOption("max-ticks", "Durée maximale d'une partie en ticks.", "n",
+                                            QString::number(BatchConfig().maxTicks));
+    const QCommandLineOption seedOption("seed", "Graine de la série.", "n", "1");
+    const QCommandLineOption threadsOption("threads", "Threads de simulation (0 = tous les cœurs).", "n", "0");
+    const QCommandLineOption spawnOption("spawn-interval", "Ticks entre deux apparitions (0 = niveau).", "n", "0");
+    const QCommandLineOption powerUpOption("powerup-chance", "Chance de power-up par ennemi détruit (%).", "pct",
+                                           QString::number(GameTuning().powerUpDropPercent));
+    for (const auto& option : {batchOption, matchesOption, maxTicksOption, seedOption,
+                               threadsOption, spawnOption, powerUpOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    BatchConfig config;
+    config.matches = qMax(1, parser.value(matchesOption).toInt());
+    config.maxTicks = qMax(1, parser.value(maxTicksOption).toInt());
+    config.seed = parser.value(seedOption).toUInt();
+    config.threads = qMax(0, parser.value(threadsOption).toInt());
+    config.tuning.spawnIntervalTicks = qMax(0, parser.value(spawnOption).toInt());
+    config.tuning.powerUpDropPercent = qBound(0, parser.value(powerUpOption).toInt(), 100);
+
+    // Les traces de debug du moteur domineraient le temps mesuré
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    BatchRunner runner(config);
+    const BatchReport report = runner.run();
+
+    double scoreSum = 0;
+    double scoreSquares = 0;
+    for (int score : report.scores) {
+        scoreSum += score;
+        scoreSquares += static_cast<double>(score) * score;
+    }
+    const double scoreMean = scoreSum / report.matches;
+    const double scoreStddev = qSqrt(qMax(0.0, scoreSquares / report.matches - scoreMean * scoreMean));
+    const double seconds = report.elapsedNs / 1.0e9;
+    const double tickSeconds = 1.0 / GameConstants::SIMULATION_RATE;
+
+    QTextStream out(stdout);
+    out << "batch_config matches=" << config.matches << " max_ticks=" << config.maxTicks
+        << " seed=" << config.seed << " threads=" << (config.threads > 0 ? config.threads : QThread::idealThreadCount())
+        << " spawn_interval=" << config.tuning.spawnIntervalTicks
+        << " powerup_chance=" << config.tuning.powerUpDropPercent << "\n";
+    out << "batch_result win_rate=" << 100.0 * report.wins / report.matches << "%"
+        << " loss_rate=" << 100.0 * report.losses / report.matches << "%"
+        << " timeout_rate=" << 100.0 * report.timeouts / report.matches << "%"
+        << " ticks_per_second=" << (seconds > 0 ? report.ticks / seconds : 0.0)
+        << " matches_per_second=" << (seconds > 0 ? report.matches / seconds : 0.0)
+        << " wall_s=" << seconds << "\n";
+    out << "batch_duration mean_s=" << report.ticks * tickSeconds / report.matches
+        << " p10_s=" << percentile(report.durations, 10) * tickSeconds
+        << " p50_s=" << percentile(report.durations, 50) * tickSeconds
+        << " p90_s=" << percentile(report.durations, 90) * tickSeconds << "\n";
+    out << "batch_score mean=" << scoreMean << " stddev=" << scoreStddev
+        << " min=" << report.scores.front()
+        << " p10=" << percentile(report.scores, 10)
+        << " p50=" << percentile(report.scores, 50)
+        << " p90=" << percentile(report.scores, 90)
+        << " max=" << report.scores.back() << "\n";
+
+    return 0;
+}
@@ -2,8 +2,8 @@
 #include "../include/Constants.hpp"
 #include <QPainter>
 
-Block::Block(const QPointF& position, BlockType blockType)
-    : Entity(QRectF(position, QSizeF(BLOCK_SIZE, BLOCK_SIZE)),
+Block::Block(const FixedPoint& position, BlockType blockType)
+    : Entity(FixedRect::square(position, BLOCK_SIZE),
              blockTypeToEntityType(blockType),
              blockTypeToColor(blockType))
     , m_blockType(blockType)
@@ -32,21 +32,10 @@ QColor Block::blockTypeToColor(BlockType type) {
     return QColor(Colors::BRICK_BLOCK);
 }
 
-bool Block::isDestructible() const {
-    return m_blockType == BlockType::BRICK;
-}
-
-bool Block::blocksMovement() const {
-    return m_blockType != BlockType::TREE;
-}
-
-bool Block::isCamouflage() const {
-    return m_blockType == BlockType::TREE;
-}
-
 void Block::render(QPainter& painter) {
     if (!m_active) return;
     
+    const QRectF rect = getRect();
     painter.save();
     painter.setBrush(m_color);
     painter.setPen(Qt::NoPen);
@@ -54,31 +43,31 @@ void Block::render(QPainter& painter) {
     switch (m_blockType) {
         case BlockType::BRICK:
             // Draw brick pattern
-            painter.drawRect(m_rect);
+            painter.drawRect(rect);
             painter.setPen(QPen(m_color.darker(150), 2));
             for (int i = 0; i < BLOCK_SIZE; i += 8) {
-                painter.drawLine(m_rect.left(), m_rect.top() + i, 
-                               m_rect.right(), m_rect.top() + i);
-                painter.drawLine(m_rect.left() + i, m_rect.top(), 
-                               m_rect.left() + i, m_rect.bottom());
+                painter.drawLine(rect.left(), rect.top() + i, 
+                               rect.right(), rect.top() + i);
+                painter.drawLine(rect.left() + i, rect.top(), 
+                               rect.left() + i, rect.bottom());
             }
             break;
             
         case BlockType::STEEL:
             // Draw steel with diagonal lines
-            painter.drawRect(m_rect);
+            painter.drawRect(rect);
             painter.setPen(QPen(m_color.lighter(120), 2));
-            painter.drawLine(m_rect.topLeft(), m_rect.bottomRight());
-            painter.drawLine(m_rect.topRight(), m_rect.bottomLeft());
+            painter.drawLine(rect.topLeft(), rect.bottomRight());
+            painter.drawLine(rect.topRight(), rect.bottomLeft());
             break;
             
         case BlockType::WATER:
             // Draw wavy water
-            painter.drawRect(m_rect);
+            painter.drawRect(rect);
             painter.setPen(QPen(m_color.lighter(130), 2));
             for (int y = 0; y < BLOCK_SIZE; y += 8) {
                 for (int x = 0; x < BLOCK_SIZE; x += 4) {
-                    painter.drawPoint(m_rect.left() + x, m_rect.top() + y);
+                    painter.drawPoint(rect.left() + x, rect.top() + y);
                 }
             }
             break;
@@ -86,19 +75,19 @@ void Block::render(QPainter& painter) {
         case BlockType::TREE:
             // Draw tree/foliage
             painter.setOpacity(0.7);
-            painter.drawRect(m_rect);
+            painter.drawRect(rect);
             painter.setOpacity(1.0);
             painter.setBrush(m_color.darker(130));
             for (int i = 0; i < 5; i++) {
-                painter.drawEllipse(m_rect.center(), 4 + i * 2, 4 + i * 2);
+                painter.drawEllipse(rect.center(), 4 + i * 2, 4 + i * 2);
             }
             break;
             
         case BlockType::BASE:
             // Draw base with eagle symbol
-            painter.drawRect(m_rect);
+            painter.drawRect(rect);
             painter.setBrush(Qt::white);
-            QRectF eagleRect = m_rect.adjusted(8, 8, -8, -8);
+            QRectF eagleRect = rect.adjusted(8, 8, -8, -8);
             painter.drawRect(eagleRect);
             break;
     }
@@ -0,0 +1,103 @@
+#include "../include/BotPlayer.hpp"
+#include <QtMath>
+#include <limits>
+
+namespace {
+InputAction moveAction(Direction direction) {
+    switch (direction) {
+        case Direction::UP: return InputAction::MOVE_UP;
+        case Direction::DOWN: return InputAction::MOVE_DOWN;
+        case Direction::LEFT: return InputAction::MOVE_LEFT;
+        case Direction::RIGHT: return InputAction::MOVE_RIGHT;
+    }
+    return InputAction::MOVE_UP;
+}
+}
+
+BotPlayer::BotPlayer(quint32 seed, quint8 player)
+    : m_random(seed)
+    , m_player(player)
+    , m_heading(Direction::UP)
+    , m_moving(false)
+    , m_stuckTicks(0)
+    , m_wanderTicks(0)
+{
+}
+
+void BotPlayer::think(GameEngine& engine) {
+    const Tank* player = m_player == 0 ? engine.getPlayer() : engine.getPartner();
+    if (!player || !player->isActive()) return;
+
+    const FixedPoint position = player->getBox().center();
+    m_stuckTicks = (m_moving && position == m_lastPosition) ? m_stuckTicks + 1 : 0;
+    m_lastPosition = position;
+
+    // Bloqué contre un mur ou un tank : errer un moment en tirant devant soi
+    if (m_stuckTicks >= STUCK_TICKS) {
+        m_stuckTicks = 0;
+        m_wanderTicks = WANDER_TICKS;
+        steer(engine, randomDirection());
+    }
+    if (m_wanderTicks > 0) {
+        m_wanderTicks--;
+        if (player->canShoot()) {
+            submit(engine, InputAction::SHOOT, true);
+        }
+        return;
+    }
+
+    // Cible : l'ennemi actif le plus proche
+    const Enemy* target = nullptr;
+    qint64 bestDistance = std::numeric_limits<qint64>::max();
+    for (const auto& enemy : engine.getEnemies()) {
+        if (!enemy->isActive()) continue;
+        const FixedPoint delta = enemy->getBox().center() - position;
+        const qint64 distance = static_cast<qint64>(delta.x) * delta.x + static_cast<qint64>(delta.y) * delta.y;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            target = enemy.get();
+        }
+    }
+    if (!target) return;
+
+    const FixedPoint delta = target->getBox().center() - position;
+    const bool sameColumn = qAbs(delta.x) < ALIGN_TOLERANCE;
+    const bool sameRow = qAbs(delta.y) < ALIGN_TOLERANCE;
+
+    Direction desired;
+    if (sameColumn) {
+        desired = delta.y < 0 ? Direction::UP : Direction::DOWN;
+    } else if (sameRow) {
+        desired = delta.x < 0 ? Direction::LEFT : Direction::RIGHT;
+    } else if (qAbs(delta.x) < qAbs(delta.y)) {
+        // Réduire le plus petit écart pour se mettre dans l'axe
+        desired = delta.x < 0 ? Direction::LEFT : Direction::RIGHT;
+    } else {
+        desired = delta.y < 0 ? Direction::UP : Direction::DOWN;
+    }
+    steer(engine, desired);
+
+    // Le tir part dans la direction courante du canon
+    if ((sameColumn || sameRow) && player->getDirection() == desired && player->canShoot()) {
+        submit(engine, InputAction::SHOOT, true);
+    }
+}
+
+void BotPlayer::steer(GameEngine& engine, Direction direction) {
+    if (m_moving && direction == m_heading) return;
+
+    if (m_moving) {
+        submit(engine, moveAction(m_heading), false);
+    }
+    submit(engine, moveAction(direction), true);
+    m_heading = direction;
+    m_moving = true;
+}
+
+void BotPlayer::submit(GameEngine& engine, InputAction action, bool pressed) {
+    engine.submitInput(InputEvent{action, pressed, m_player});
+}
+
+Direction BotPlayer::randomDirection() {
+    return static_cast<Direction>(m_random.bounded(4));
+}
@@ -2,60 +2,60 @@
 #include "../include/Constants.hpp"
 #include <QPainter>
 
-Bullet::Bullet(const QPointF& position, Direction direction, bool fromPlayer)
-    : Entity(QRectF(position, QSizeF(BULLET_SIZE, BULLET_SIZE)),
+Bullet::Bullet(const FixedPoint& position, Direction direction, bool fromPlayer)
+    : Entity(FixedRect::square(position, BULLET_SIZE),
              EntityType::BULLET,
              QColor(Colors::BULLET))
     , m_direction(direction)
-    , m_speed(GameConstants::BULLET_SPEED)
+    , m_speed(Fixed::fromPixels(GameConstants::BULLET_SPEED))
     , m_fromPlayer(fromPlayer)
 {
     // Ajuster la position initiale pour centrer la balle sur le canon
-    QPointF adjustedPos = position;
-    adjustedPos.setX(adjustedPos.x() - BULLET_SIZE / 2);
-    adjustedPos.setY(adjustedPos.y() - BULLET_SIZE / 2);
-    m_rect.moveTo(adjustedPos);
+    const qint32 halfSize = Fixed::fromPixels(BULLET_SIZE) / 2;
+    m_box.moveTo(position - FixedPoint(halfSize, halfSize));
+    savePreviousPosition();
 }
 
 void Bullet::update() {
     if (!m_active) return;
 
-    QPointF currentPos = m_rect.topLeft();
-    QPointF newPos = currentPos;
+    const FixedPoint currentPos = m_box.topLeft();
+    FixedPoint newPos = currentPos;
 
     // Mouvement progressif dans la direction
     switch (m_direction) {
     case Direction::UP:
-        newPos.setY(currentPos.y() - m_speed);
+        newPos.y = currentPos.y - m_speed;
         break;
     case Direction::DOWN:
-        newPos.setY(currentPos.y() + m_speed);
+        newPos.y = currentPos.y + m_speed;
         break;
     case Direction::LEFT:
-        newPos.setX(currentPos.x() - m_speed);
+        newPos.x = currentPos.x - m_speed;
         break;
     case Direction::RIGHT:
-        newPos.setX(currentPos.x() + m_speed);
+        newPos.x = currentPos.x + m_speed;
         break;
     }
 
     // Vérifier les limites avec marge généreuse
-    const int MARGIN = 50;
-    if (newPos.x() < -MARGIN ||
-        newPos.x() > GameConstants::GAME_AREA_WIDTH + MARGIN ||
-        newPos.y() < -MARGIN ||
-        newPos.y() > GameConstants::GAME_AREA_HEIGHT + MARGIN) {
+    constexpr qint32 MARGIN = Fixed::fromPixels(50);
+    if (newPos.x < -MARGIN ||
+        newPos.x > Fixed::fromPixels(GameConstants::GAME_AREA_WIDTH) + MARGIN ||
+        newPos.y < -MARGIN ||
+        newPos.y > Fixed::fromPixels(GameConstants::GAME_AREA_HEIGHT) + MARGIN) {
         m_active = false;
         return;
     }
 
     // Appliquer le mouvement
-    m_rect.moveTo(newPos);
+    m_box.moveTo(newPos);
 }
 
 void Bullet::render(QPainter& painter) {
     if (!m_active) return;
 
+    const QRectF rect = getRect();
     painter.save();
 
     // Dessiner une balle plus visible avec un effet brillant
@@ -63,10 +63,10 @@ void Bullet::render(QPainter& painter) {
     painter.setPen(QPen(m_color.lighter(150), 1));
 
     // Cercle principal
-    painter.drawEllipse(m_rect);
+    painter.drawEllipse(rect);
 
     // Point lumineux au centre
-    QPointF center = m_rect.center();
+    QPointF center = rect.center();
     painter.setBrush(Qt::white);
     painter.drawEllipse(center, BULLET_SIZE / 4, BULLET_SIZE / 4);
 
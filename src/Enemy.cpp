@@ -2,12 +2,18 @@
 #include "../include/Constants.hpp"
 #include <QRandomGenerator>
 
-Enemy::Enemy(const QPointF& position)
+Enemy::Enemy(const FixedPoint& position)
+    : Enemy(position, QRandomGenerator::global()->generate())
+{
+}
+
+Enemy::Enemy(const FixedPoint& position, quint32 seed)
     : Tank(position, EntityType::ENEMY_TANK, QColor(Colors::ENEMY_TANK), 
            GameConstants::ENEMY_SPEED)
     , m_aiTimer(0)
     , m_shootTimer(0)
     , m_directionChangeTimer(DIRECTION_CHANGE_INTERVAL)
+    , m_randomState(seed != 0 ? seed : 0x9E3779B9u)   // 0 bloquerait xorshift
 {
     setHealth(1);
 }
@@ -31,7 +37,7 @@ void Enemy::updateAI() {
         setMoving(getDirection(), false);
         setMoving(newDir, true);
         m_directionChangeTimer = DIRECTION_CHANGE_INTERVAL + 
-                                 QRandomGenerator::global()->bounded(60);
+                                 nextRandom(60);
     }
 }
 
@@ -40,7 +46,7 @@ bool Enemy::shouldShoot() const {
 }
 
 Direction Enemy::getRandomDirection() {
-    int random = QRandomGenerator::global()->bounded(4);
+    int random = nextRandom(4);
     switch (random) {
         case 0: return Direction::UP;
         case 1: return Direction::DOWN;
@@ -49,3 +55,10 @@ Direction Enemy::getRandomDirection() {
     }
     return Direction::UP;
 }
+
+int Enemy::nextRandom(int bound) {
+    m_randomState ^= m_randomState << 13;
+    m_randomState ^= m_randomState >> 17;
+    m_randomState ^= m_randomState << 5;
+    return static_cast<int>(m_randomState % static_cast<quint32>(bound));
+}
@@ -1,10 +1,21 @@
 #include "../include/Entity.hpp"
+#include <atomic>
 
-Entity::Entity(const QRectF& rect, EntityType type, const QColor& color)
-    : m_rect(rect)
+namespace {
+// Atomique : les blocs d'un niveau sont créés sur un thread de travail
+std::atomic<quint32> s_nextEntityId{1};
+}
+
+Entity::Entity(const FixedRect& box, EntityType type, const QColor& color)
+    : m_id(s_nextEntityId.fetch_add(1, std::memory_order_relaxed))
+    , m_box(box)
+    , m_previousPosition(box.topLeft())
     , m_type(type)
     , m_color(color)
     , m_active(true)
+    , m_checkedPosition(box.topLeft())
+    , m_checkedActive(false)
+    , m_collisionDirty(true)
 {
 }
 
@@ -14,15 +25,22 @@ void Entity::render(QPainter& painter) {
     painter.save();
     painter.setBrush(m_color);
     painter.setPen(Qt::NoPen);
-    painter.drawRect(m_rect);
+    painter.drawRect(getRect());
     painter.restore();
 }
 
-void Entity::setPosition(const QPointF& pos) {
-    m_rect.moveTo(pos);
+QRectF Entity::getRenderBounds() const {
+    // Marge pour les contours et l'antialiasing
+    return getRect().adjusted(-2, -2, 2, 2);
+}
+
+QPointF Entity::getInterpolatedPosition(qreal alpha) const {
+    // alpha = 0 -> état du tick précédent, alpha = 1 -> état courant
+    const QPointF previous = m_previousPosition.toPointF();
+    return previous + (getPosition() - previous) * alpha;
 }
 
 bool Entity::collidesWith(const Entity& other) const {
     if (!m_active || !other.isActive()) return false;
-    return m_rect.intersects(other.getRect());
+    return m_box.intersects(other.getBox());
 }
\ No newline at end of file
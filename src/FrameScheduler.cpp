@@ -0,0 +1,142 @@
+#include "../include/FrameScheduler.hpp"
+#include "../include/Profiler.hpp"
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+
+FrameScheduler::FrameScheduler(QObject* parent)
+    : QObject(parent)
+    , m_lastFrameTime(0)
+    , m_accumulator(0)
+    , m_lastStatsLog(0)
+    , m_intervalIndex(0)
+{
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(1000 / GameConstants::DEFAULT_REFRESH_RATE);
+    connect(m_timer, &QTimer::timeout, this, &FrameScheduler::onTimeout);
+
+    m_intervals.reserve(INTERVAL_HISTORY);
+}
+
+void FrameScheduler::start() {
+    m_accumulator = 0;
+    m_clock.start();
+    m_lastFrameTime = 0;
+    m_lastStatsLog = 0;
+    m_timer->start();
+}
+
+void FrameScheduler::resume() {
+    if (!m_clock.isValid()) {
+        start();
+        return;
+    }
+    m_lastFrameTime = m_clock.nsecsElapsed();
+    m_timer->start();
+}
+
+void FrameScheduler::stop() {
+    m_timer->stop();
+}
+
+void FrameScheduler::setDisplayRefreshRate(qreal hz) {
+    if (hz <= 0) {
+        hz = GameConstants::DEFAULT_REFRESH_RATE;
+    }
+    // Une frame par rafraîchissement écran (60, 120, 144 Hz...)
+    m_timer->setInterval(qMax(1, qFloor(1000.0 / hz)));
+    qDebug() << "Fréquence d'affichage:" << hz << "Hz";
+}
+
+qreal FrameScheduler::getInterpolationAlpha() const {
+    return qBound(0.0, static_cast<qreal>(m_accumulator) / TICK_NS, 1.0);
+}
+
+void FrameScheduler::onTimeout() {
+    const qint64 now = m_clock.nsecsElapsed();
+    const qint64 delta = now - m_lastFrameTime;
+    m_lastFrameTime = now;
+
+    Profiler::instance().beginFrame();
+    recordInterval(delta);
+    m_accumulator += delta;
+
+    // Rattrapage borné : la simulation avance par pas fixes
+    int steps = 0;
+    while (m_accumulator >= TICK_NS && steps < MAX_CATCHUP_TICKS) {
+        emit tick();
+        m_accumulator -= TICK_NS;
+        m_stats.ticks++;
+        steps++;
+
+        // Le tick peut avoir arrêté la partie (game over, niveau terminé)
+        if (!isRunning()) break;
+    }
+
+    // Trop de retard : abandonner les pas restants au lieu de s'emballer
+    if (m_accumulator >= TICK_NS && isRunning()) {
+        const qint64 dropped = m_accumulator / TICK_NS;
+        m_accumulator -= dropped * TICK_NS;
+        m_stats.missedTicks += static_cast<quint64>(dropped);
+        m_stats.spiralEvents++;
+        qWarning() << "FrameScheduler: retard de" << dropped << "ticks abandonnés";
+    }
+
+    m_stats.frames++;
+    emit frame();
+
+    if (now - m_lastStatsLog >= STATS_LOG_INTERVAL_NS) {
+        m_lastStatsLog = now;
+        logStats();
+    }
+}
+
+void FrameScheduler::recordInterval(qint64 intervalNs) {
+    if (m_intervals.size() < static_cast<size_t>(INTERVAL_HISTORY)) {
+        m_intervals.push_back(intervalNs);
+    } else {
+        m_intervals[m_intervalIndex] = intervalNs;
+    }
+    m_intervalIndex = (m_intervalIndex + 1) % INTERVAL_HISTORY;
+}
+
+FrameStats FrameScheduler::getStats() const {
+    FrameStats stats = m_stats;
+    if (m_intervals.empty()) {
+        return stats;
+    }
+
+    std::vector<qint64> sorted(m_intervals);
+    const size_t p99Index = (sorted.size() * 99) / 100;
+    std::nth_element(sorted.begin(), sorted.begin() + p99Index, sorted.end());
+
+    qint64 total = 0;
+    qint64 maximum = 0;
+    for (qint64 interval : m_intervals) {
+        total += interval;
+        maximum = qMax(maximum, interval);
+    }
+
+    stats.meanIntervalMs = total / 1.0e6 / m_intervals.size();
+    stats.p99IntervalMs = sorted[p99Index] / 1.0e6;
+    stats.maxIntervalMs = maximum / 1.0e6;
+    return stats;
+}
+
+void FrameScheduler::resetStats() {
+    m_stats = FrameStats();
+    m_intervals.clear();
+    m_intervalIndex = 0;
+}
+
+void FrameScheduler::logStats() {
+    const FrameStats stats = getStats();
+    qInfo().nospace() << "frame_stats mean_ms=" << stats.meanIntervalMs
+                      << " p99_ms=" << stats.p99IntervalMs
+                      << " max_ms=" << stats.maxIntervalMs
+                      << " frames=" << stats.frames
+                      << " ticks=" << stats.ticks
+                      << " missed_ticks=" << stats.missedTicks
+                      << " spiral_events=" << stats.spiralEvents;
+}
@@ -1,27 +1,72 @@
 #include "../include/GameEngine.hpp"
 #include "../include/Constants.hpp"
 #include "../include/GameConfig.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/CollisionLayers.hpp"
+#include "../include/LevelGenerator.hpp"
+#include "../include/LevelFile.hpp"
 #include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QtConcurrent>
 #include <algorithm>
+#include <limits>
 #include <QDebug>
 #include <QtMath>
 
+namespace {
+// Case de la grille contenant un point de la zone de jeu
+QPoint cellAt(const QPointF& point) {
+    return QPoint(qFloor(point.x() / GameConstants::CELL_SIZE),
+                  qFloor(point.y() / GameConstants::CELL_SIZE));
+}
+
+// Cases recouvertes, même partiellement, par un rectangle
+QRect cellsCovering(const QRectF& rect) {
+    return QRect(cellAt(rect.topLeft()), cellAt(rect.bottomRight() - QPointF(0.01, 0.01)));
+}
+
+FixedPoint cellOrigin(const QPoint& cell) {
+    return FixedPoint::fromPixels(cell.x() * GameConstants::CELL_SIZE, cell.y() * GameConstants::CELL_SIZE);
+}
+
+BlockType blockTypeFor(Tile tile) {
+    switch (tile) {
+        case Tile::STEEL: return BlockType::STEEL;
+        case Tile::WATER: return BlockType::WATER;
+        case Tile::TREE: return BlockType::TREE;
+        case Tile::BASE: return BlockType::BASE;
+        default: return BlockType::BRICK;
+    }
+}
+}
+
 GameEngine::GameEngine(QObject* parent)
     : QObject(parent)
     , m_state(GameState::MENU)
+    , m_playerCount(1)
+    , m_random(QRandomGenerator::global()->generate())
+    , m_parallelCollisions(true)
+    , m_preloadNextLevel(true)
     , m_score(0)
     , m_level(1)
+    , m_levelSeed(0)
+    , m_waveIndex(0)
+    , m_waveSpawned(0)
     , m_enemiesRemaining(0)
     , m_activeEnemies(0)
     , m_baseDestroyed(false)
+    , m_tickCount(0)
+    , m_spawnTickCounter(0)
+    , m_dirtyOverflow(false)
+    , m_scoreDirty(false)
+    , m_healthDirty(false)
+    , m_resimulating(false)
+    , m_sessionDriven(false)
 {
-    m_gameTimer = new QTimer(this);
-    m_gameTimer->setInterval(GameConstants::GAME_TICK_INTERVAL);
-    connect(m_gameTimer, &QTimer::timeout, this, &GameEngine::update);
-
-    m_enemySpawnTimer = new QTimer(this);
-    m_enemySpawnTimer->setInterval(GameConstants::ENEMY_SPAWN_INTERVAL);
-    connect(m_enemySpawnTimer, &QTimer::timeout, this, &GameEngine::spawnEnemy);
+    m_events.reserve(64);
+    m_scheduler = new FrameScheduler(this);
+    connect(m_scheduler, &FrameScheduler::tick, this, &GameEngine::update);
+    connect(m_scheduler, &FrameScheduler::frame, this, &GameEngine::frameAdvanced);
 }
 
 GameEngine::~GameEngine() = default;
@@ -31,11 +76,13 @@ void GameEngine::startGame() {
     m_score = 0;
     m_level = 1;
     m_baseDestroyed = false;
+    // Un niveau préparé en fond pour l'ancienne partie est abandonné
+    m_nextLevel = QFuture<std::shared_ptr<PreparedLevel>>();
 
     initializeLevel();
 
-    m_gameTimer->start();
-    m_enemySpawnTimer->start();
+    m_scheduler->resetStats();
+    m_scheduler->start();
 
     emit gameStateChanged(m_state);
     emit scoreChanged(m_score);
@@ -44,166 +91,640 @@ void GameEngine::startGame() {
     qDebug() << "=== Jeu démarré ===";
 }
 
-void GameEngine::initializeLevel() {
+void GameEngine::startHeadless() {
+    m_score = 0;
+    m_level = 1;
+    m_baseDestroyed = false;
+    m_nextLevel = QFuture<std::shared_ptr<PreparedLevel>>();
+
+    initializeLevel();
+    m_state = GameState::PLAYING;
+}
+
+FrameScheduler* GameEngine::detachScheduler() {
+    disconnect(m_scheduler, &FrameScheduler::tick, this, &GameEngine::update);
+    m_sessionDriven = true;
+    return m_scheduler;
+}
+
+void GameEngine::addEnemy(std::unique_ptr<Enemy> enemy) {
+    m_enemies.push_back(std::move(enemy));
+    m_activeEnemies++;
+}
+
+void GameEngine::reviveHeadless() {
+    m_state = GameState::PLAYING;
+    m_baseDestroyed = false;
+    m_player->setActive(true);
+    m_player->setHealth(GameConstants::MAX_PLAYER_HEALTH);
+}
+
+void GameEngine::initializeLevel(std::shared_ptr<PreparedLevel> prepared) {
     m_enemies.clear();
     m_bullets.clear();
     m_blocks.clear();
     m_powerUps.clear();
 
-    m_enemiesRemaining = GameConstants::MAX_ENEMIES;
     m_activeEnemies = 0;
+    m_spawnTickCounter = 0;
+    m_events.clear();
+    m_input.clear();
+    m_carriedInput.clear();
+    m_scoreDirty = false;
+    m_healthDirty = false;
 
     // IMPORTANT: Créer le niveau AVANT le joueur
-    createLevel();
+    if (prepared && prepared->level == m_level) {
+        installLevel(*prepared);
+    } else {
+        createLevel();
+    }
 
-    // Créer le joueur au centre en bas (APRÈS la création du niveau)
-    QPointF playerStart(GameConstants::GAME_AREA_WIDTH / 2 - 14,
-                        GameConstants::GAME_AREA_HEIGHT - 50);
+    // Les vagues du niveau fixent le nombre d'ennemis à vaincre
+    m_waveIndex = 0;
+    m_waveSpawned = 0;
+    m_enemiesRemaining = 0;
+    for (const LevelWave& wave : m_waves) {
+        m_enemiesRemaining += wave.enemies;
+    }
+
+    // Créer le joueur (APRÈS la création du niveau)
+    const FixedPoint playerStart = m_playerStart;
     m_player = std::make_unique<Tank>(playerStart, EntityType::PLAYER_TANK,
                                       GameConfig::instance().getTankColor(),
                                       GameConstants::PLAYER_SPEED);
 
+    createPartner();
+
     emit playerHealthChanged(m_player->getHealth());
 
+    // Nouveau terrain : toute la zone de jeu doit être redessinée
+    markFullRepaint();
+
     qDebug() << "Niveau" << m_level << "initialisé";
-    qDebug() << "Joueur créé à:" << playerStart;
+    qDebug() << "Joueur créé à:" << playerStart.toPointF();
     qDebug() << "Ennemis à vaincre:" << m_enemiesRemaining;
 }
 
+void GameEngine::createPartner() {
+    m_partner.reset();
+    if (m_playerCount < 2) return;
+
+    // À côté du joueur, sur la première place libre (même choix sur chaque pair)
+    static constexpr int offsets[] = {64, -64, 96, -96, 128, -128};
+    FixedPoint start = m_playerStart + FixedPoint::fromPixels(offsets[0], 0);
+    for (int offset : offsets) {
+        const FixedPoint candidate = m_playerStart + FixedPoint::fromPixels(offset, 0);
+        if (isValidMove(FixedRect::square(candidate, 28))) {
+            start = candidate;
+            break;
+        }
+    }
+    m_partner = std::make_unique<Tank>(start, EntityType::PLAYER_TANK,
+                                       QColor(Colors::PARTNER_TANK), GameConstants::PLAYER_SPEED);
+}
+
+bool GameEngine::anyPlayerActive() const {
+    return m_player->isActive() || (m_partner && m_partner->isActive());
+}
+
+void GameEngine::saveSnapshot(EngineSnapshot& snapshot) const {
+    // Copies profondes : le rollback ne doit partager aucune entité vivante
+    snapshot.state = m_state;
+    snapshot.player = std::make_unique<Tank>(*m_player);
+    snapshot.partner = m_partner ? std::make_unique<Tank>(*m_partner) : nullptr;
+
+    snapshot.enemies.clear();
+    for (const auto& enemy : m_enemies) snapshot.enemies.push_back(std::make_unique<Enemy>(*enemy));
+    snapshot.bullets.clear();
+    for (const auto& bullet : m_bullets) snapshot.bullets.push_back(std::make_unique<Bullet>(*bullet));
+    snapshot.blocks.clear();
+    for (const auto& block : m_blocks) snapshot.blocks.push_back(std::make_unique<Block>(*block));
+    snapshot.powerUps.clear();
+    for (const auto& powerUp : m_powerUps) snapshot.powerUps.push_back(std::make_unique<PowerUp>(*powerUp));
+
+    snapshot.random = m_random;
+    snapshot.score = m_score;
+    snapshot.waveIndex = m_waveIndex;
+    snapshot.waveSpawned = m_waveSpawned;
+    snapshot.enemiesRemaining = m_enemiesRemaining;
+    snapshot.activeEnemies = m_activeEnemies;
+    snapshot.baseDestroyed = m_baseDestroyed;
+    snapshot.tickCount = m_tickCount;
+    snapshot.spawnTickCounter = m_spawnTickCounter;
+    snapshot.carriedInput = m_carriedInput;
+}
+
+void GameEngine::restoreSnapshot(const EngineSnapshot& snapshot) {
+    m_state = snapshot.state;
+    m_player = std::make_unique<Tank>(*snapshot.player);
+    m_partner = snapshot.partner ? std::make_unique<Tank>(*snapshot.partner) : nullptr;
+
+    m_enemies.clear();
+    for (const auto& enemy : snapshot.enemies) m_enemies.push_back(std::make_unique<Enemy>(*enemy));
+    m_bullets.clear();
+    for (const auto& bullet : snapshot.bullets) m_bullets.push_back(std::make_unique<Bullet>(*bullet));
+    m_blocks.clear();
+    for (const auto& block : snapshot.blocks) m_blocks.push_back(std::make_unique<Block>(*block));
+    m_powerUps.clear();
+    for (const auto& powerUp : snapshot.powerUps) m_powerUps.push_back(std::make_unique<PowerUp>(*powerUp));
+
+    m_random = snapshot.random;
+    m_score = snapshot.score;
+    m_waveIndex = snapshot.waveIndex;
+    m_waveSpawned = snapshot.waveSpawned;
+    m_enemiesRemaining = snapshot.enemiesRemaining;
+    m_activeEnemies = snapshot.activeEnemies;
+    m_baseDestroyed = snapshot.baseDestroyed;
+    m_tickCount = snapshot.tickCount;
+    m_spawnTickCounter = snapshot.spawnTickCounter;
+    m_carriedInput = snapshot.carriedInput;
+
+    // m_input est conservé : la session l'a vidé avant le retour arrière
+    // et y replace ensuite les entrées locales pas encore relevées
+    m_events.clear();
+    m_scoreDirty = true;
+    m_healthDirty = true;
+    markFullRepaint();
+}
+
+quint64 GameEngine::stateHash() const {
+    // FNV-1a sur les grandeurs entières de la simulation
+    quint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](qint64 value) {
+        for (int i = 0; i < 8; i++) {
+            hash ^= static_cast<quint8>(value >> (i * 8));
+            hash *= 1099511628211ULL;
+        }
+    };
+    auto mixTank = [&mix](const Tank& tank) {
+        mix(tank.getBox().x);
+        mix(tank.getBox().y);
+        mix(static_cast<int>(tank.getDirection()));
+        mix(tank.getHealth());
+        mix(tank.isActive());
+    };
+
+    mix(m_tickCount);
+    mix(m_score);
+    mix(m_enemiesRemaining);
+    mix(m_activeEnemies);
+    mix(m_baseDestroyed);
+    mixTank(*m_player);
+    if (m_partner) mixTank(*m_partner);
+    for (const auto& enemy : m_enemies) mixTank(*enemy);
+    for (const auto& bullet : m_bullets) {
+        mix(bullet->getBox().x);
+        mix(bullet->getBox().y);
+        mix(bullet->isFromPlayer());
+    }
+    // Terrain : position de chaque bloc restant (les identifiants dépendent
+    // de l'ordre des créations dans chaque processus, pas de la partie)
+    mix(static_cast<qint64>(m_blocks.size()));
+    for (const auto& block : m_blocks) {
+        mix(block->getBox().x);
+        mix(block->getBox().y);
+        mix(block->isActive());
+    }
+    for (const auto& powerUp : m_powerUps) {
+        mix(powerUp->getBox().x);
+        mix(powerUp->getBox().y);
+        mix(static_cast<int>(powerUp->getPowerUpType()));
+    }
+    return hash;
+}
+
+void GameEngine::setCampaign(const QStringList& levelFiles) {
+    m_campaign = levelFiles;
+    qDebug() << "Campagne:" << m_campaign.size() << "niveau(x)";
+}
+
 void GameEngine::createLevel() {
+    installLevel(*buildLevel(m_level, m_campaign, m_random.generate()));
+}
+
+void GameEngine::installLevel(PreparedLevel& level) {
+    // Échange : le niveau préparé est déplacé, rien n'est recopié
+    for (auto& block : level.blocks) {
+        m_blocks.push_back(std::move(block));
+    }
+    m_levelSeed = level.seed;
+    m_playerStart = level.playerStart;
+    m_spawnPoints = std::move(level.spawnPoints);
+    m_waves = std::move(level.waves);
+}
+
+std::shared_ptr<PreparedLevel> GameEngine::buildLevel(int levelNumber, const QStringList& campaign, quint32 seed) {
+    auto level = std::make_shared<PreparedLevel>();
+    level->level = levelNumber;
+    level->seed = seed;
+
+    // Niveaux dessinés à la main en priorité, terrain généré sinon
+    if (!campaign.isEmpty()) {
+        const QString& path = campaign.at((levelNumber - 1) % campaign.size());
+        if (loadLevel(path, *level)) {
+            return level;
+        }
+        qWarning() << "Niveau de campagne ignoré, terrain généré à la place";
+    }
+    generateLevel(*level);
+    return level;
+}
+
+bool GameEngine::loadLevel(const QString& path, PreparedLevel& level) {
+    QElapsedTimer timer;
+    timer.start();
+
+    LevelFile file;
+    if (!file.open(path)) {
+        qWarning() << "Niveau illisible:" << path << "-" << file.errorString();
+        return false;
+    }
+
+    // Les cases sont lues dans le fichier projeté, les blocs alloués d'un bloc
+    int occupied = 0;
+    for (int y = 0; y < file.height(); y++) {
+        for (int x = 0; x < file.width(); x++) {
+            occupied += file.tileAt(x, y) != Tile::EMPTY ? 1 : 0;
+        }
+    }
+    level.blocks.reserve(occupied);
+
+    for (int y = 0; y < file.height(); y++) {
+        for (int x = 0; x < file.width(); x++) {
+            const Tile tile = file.tileAt(x, y);
+            if (tile != Tile::EMPTY) {
+                level.blocks.push_back(std::make_unique<Block>(cellOrigin(QPoint(x, y)), blockTypeFor(tile)));
+            }
+        }
+    }
+
+    // Tanks de 28 pixels centrés dans leur case
+    const FixedPoint tankOffset = FixedPoint::fromPixels(2, 2);
+    level.playerStart = cellOrigin(file.playerSpawn()) + tankOffset;
+
+    for (int i = 0; i < file.spawnCount(); i++) {
+        level.spawnPoints.push_back(cellOrigin(file.spawnAt(i)) + tankOffset);
+    }
+
+    for (int i = 0; i < file.waveCount(); i++) {
+        level.waves.push_back(file.waveAt(i));
+    }
+    if (level.waves.empty()) {
+        level.waves.push_back(defaultWave());
+    }
+
+    qDebug() << "Niveau chargé:" << path << "-" << level.blocks.size() << "blocs en"
+             << timer.nsecsElapsed() / 1000 << "µs";
+    return true;
+}
+
+void GameEngine::generateLevel(PreparedLevel& level) {
     // Position de la base au centre en bas
-    QPointF basePos(GameConstants::GAME_AREA_WIDTH / 2 - 16,
-                    GameConstants::GAME_AREA_HEIGHT - 64);
-    m_blocks.push_back(std::make_unique<Block>(basePos, BlockType::BASE));
+    QPoint basePos(GameConstants::GAME_AREA_WIDTH / 2 - 16,
+                   GameConstants::GAME_AREA_HEIGHT - 64);
+    level.blocks.push_back(std::make_unique<Block>(FixedPoint::fromPixels(basePos), BlockType::BASE));
 
     // Position du joueur (pour éviter de placer des blocs ici)
-    QPointF playerSpawn(GameConstants::GAME_AREA_WIDTH / 2 - 14,
-                        GameConstants::GAME_AREA_HEIGHT - 50);
+    QPoint playerSpawn(GameConstants::GAME_AREA_WIDTH / 2 - 14,
+                       GameConstants::GAME_AREA_HEIGHT - 50);
     QRectF playerArea(playerSpawn.x() - 32, playerSpawn.y() - 32, 96, 96);
 
     // Créer des murs protecteurs autour de la base (mais pas sur le joueur)
     for (int i = -2; i <= 2; i++) {
         if (i == 0) continue;
-        QPointF pos(basePos.x() + i * GameConstants::CELL_SIZE, basePos.y() - 32);
+        QPoint pos(basePos.x() + i * GameConstants::CELL_SIZE, basePos.y() - 32);
 
         // Ne pas placer de mur si ça bloque le joueur
         QRectF blockRect(pos, QSizeF(32, 32));
         if (!blockRect.intersects(playerArea)) {
-            m_blocks.push_back(std::make_unique<Block>(pos, BlockType::BRICK));
+            level.blocks.push_back(std::make_unique<Block>(FixedPoint::fromPixels(pos), BlockType::BRICK));
         }
     }
 
-    // Créer un niveau aléatoire
-    for (int y = 0; y < GameConstants::GRID_HEIGHT - 5; y++) {  // -5 au lieu de -3 pour plus d'espace en bas
-        for (int x = 0; x < GameConstants::GRID_WIDTH; x++) {
-            QPointF pos(x * GameConstants::CELL_SIZE, y * GameConstants::CELL_SIZE);
-            QRectF blockRect(pos, QSizeF(32, 32));
+    // Terrain généré : chaque point d'apparition reste relié à la base
+    LevelSpec spec;
+    spec.width = GameConstants::GRID_WIDTH;
+    spec.height = GameConstants::GRID_HEIGHT;
+    spec.target = cellAt(basePos + QPoint(16, 16));
+    spec.sources.push_back(cellAt(playerSpawn + QPoint(14, 14)));
+    // Bas de carte réservé à la base et au joueur
+    spec.clearAreas.push_back(QRect(0, GameConstants::GRID_HEIGHT - 5, GameConstants::GRID_WIDTH, 5));
+    spec.clearAreas.push_back(cellsCovering(playerArea));
+    for (int i = 0; i < SPAWN_POINTS; i++) {
+        const QRectF spawnRect(getSpawnPosition(i).toPointF(), QSizeF(28, 28));
+        spec.sources.push_back(cellAt(spawnRect.center()));
+        spec.clearAreas.push_back(cellsCovering(spawnRect).adjusted(-1, -1, 1, 1));
+    }
 
-            // Ne JAMAIS placer de bloc dans la zone de spawn du joueur
-            if (blockRect.intersects(playerArea)) {
-                continue;
-            }
+    QElapsedTimer timer;
+    timer.start();
 
-            // Réduire la densité de blocs à 20%
-            if (QRandomGenerator::global()->bounded(100) < 20) {
-                int blockChoice = QRandomGenerator::global()->bounded(100);
-                if (blockChoice < 60) {
-                    m_blocks.push_back(std::make_unique<Block>(pos, BlockType::BRICK));
-                } else if (blockChoice < 75) {
-                    m_blocks.push_back(std::make_unique<Block>(pos, BlockType::STEEL));
-                } else if (blockChoice < 85) {
-                    m_blocks.push_back(std::make_unique<Block>(pos, BlockType::WATER));
-                } else {
-                    m_blocks.push_back(std::make_unique<Block>(pos, BlockType::TREE));
-                }
-            }
+    LevelGenerator generator(level.seed);
+    const LevelLayout layout = generator.generate(spec);
+    const qint64 generationNs = timer.nsecsElapsed();
+
+    for (int y = 0; y < layout.height; y++) {
+        for (int x = 0; x < layout.width; x++) {
+            const Tile tile = layout.at(x, y);
+            if (tile == Tile::EMPTY) continue;
+
+            level.blocks.push_back(std::make_unique<Block>(cellOrigin(QPoint(x, y)), blockTypeFor(tile)));
         }
     }
 
-    qDebug() << "Niveau créé avec" << m_blocks.size() << "blocs";
+    level.playerStart = FixedPoint::fromPixels(playerSpawn);
+    for (int i = 0; i < SPAWN_POINTS; i++) {
+        level.spawnPoints.push_back(getSpawnPosition(i));
+    }
+    level.waves.assign(1, defaultWave());
+
+    qDebug() << "Terrain généré en" << generationNs / 1000 << "µs - graine:" << level.seed;
+    qDebug() << "Niveau créé avec" << level.blocks.size() << "blocs";
     qDebug() << "Zone de spawn joueur protégée:" << playerArea;
 }
 
+void GameEngine::prepareNextLevel() {
+    // Construit pendant l'écran de fin de niveau, sur le pool de threads.
+    // Graine tirée même sans préparation : la suite aléatoire ne change pas.
+    const quint32 seed = m_random.generate();
+    if (!m_preloadNextLevel) return;
+    m_nextLevel = QtConcurrent::run(&GameEngine::buildLevel, m_level + 1, m_campaign, seed);
+}
+
+void GameEngine::nextLevel() {
+    if (m_state != GameState::LEVEL_COMPLETE) return;
+
+    std::shared_ptr<PreparedLevel> prepared;
+    if (m_nextLevel.isValid()) {
+        if (!m_nextLevel.isFinished()) {
+            qDebug() << "Niveau suivant pas encore prêt, attente";
+        }
+        prepared = m_nextLevel.result();
+        m_nextLevel = QFuture<std::shared_ptr<PreparedLevel>>();
+    }
+
+    m_level++;
+    m_score += GameConstants::LEVEL_COMPLETE_BONUS;
+    m_state = GameState::PLAYING;
+    m_baseDestroyed = false;
+
+    initializeLevel(prepared);
+
+    m_scheduler->start();
+
+    emit gameStateChanged(m_state);
+    emit scoreChanged(m_score);
+    emit levelChanged(m_level);
+
+    qDebug() << "=== Niveau" << m_level << "===";
+}
+
+void GameEngine::setDisplayRefreshRate(qreal hz) {
+    m_scheduler->setDisplayRefreshRate(hz);
+}
+
+qreal GameEngine::getInterpolationAlpha() const {
+    return m_scheduler->getInterpolationAlpha();
+}
+
+QRegion GameEngine::takeDirtyRegion() {
+    QRegion region;
+    if (m_dirtyOverflow) {
+        region = QRect(0, 0, GameConstants::GAME_AREA_WIDTH, GameConstants::GAME_AREA_HEIGHT);
+    } else {
+        for (const QRect& rect : m_dirtyRects) {
+            region += rect;
+        }
+    }
+
+    m_dirtyRects.clear();
+    m_dirtyOverflow = false;
+    return region;
+}
+
+void GameEngine::markDirty(const QRectF& bounds) {
+    if (m_dirtyOverflow) return;
+
+    if (static_cast<int>(m_dirtyRects.size()) >= GameConstants::MAX_DIRTY_RECTS) {
+        markFullRepaint();
+        return;
+    }
+    m_dirtyRects.push_back(bounds.toAlignedRect());
+}
+
+template <typename T>
+void GameEngine::markEntityDirty(const T& entity) {
+    // Union des bornes à la position précédente et à la position courante
+    const QRectF bounds = entity.T::getRenderBounds();
+    const QPointF delta = entity.getPreviousPosition() - entity.getPosition();
+
+    if (delta.isNull()) {
+        markDirty(bounds);
+    } else {
+        markDirty(bounds.united(bounds.translated(delta)));
+    }
+}
+
+void GameEngine::markChangedEntities() {
+    // Les tanks sont peu nombreux et animés (canon, bouclier) : toujours repeints
+    markEntityDirty(*m_player);
+    if (m_partner) {
+        markEntityDirty(*m_partner);
+    }
+    for (const auto& enemy : m_enemies) {
+        markEntityDirty(*enemy);
+    }
+
+    // Les balles bougent à chaque tick
+    for (const auto& bullet : m_bullets) {
+        markEntityDirty(*bullet);
+    }
+
+    // Power-ups : seulement s'ils clignotent ou vont disparaître
+    for (const auto& powerUp : m_powerUps) {
+        if (!powerUp->isActive() || powerUp->isBlinking()) {
+            markEntityDirty(*powerUp);
+        }
+    }
+
+    // Blocs : seulement ceux détruits pendant ce tick
+    for (const auto& block : m_blocks) {
+        if (!block->isActive()) {
+            markEntityDirty(*block);
+        }
+    }
+}
+
+void GameEngine::markFullRepaint() {
+    m_dirtyRects.clear();
+    m_dirtyOverflow = true;
+}
+
+void GameEngine::dispatchEvents() {
+    // Ticks rejoués : sons et signaux ont déjà été émis la première fois
+    if (m_resimulating) {
+        m_events.clear();
+        return;
+    }
+
+    if (!m_events.empty()) {
+        emit gameEvents(m_events);
+        m_events.clear();   // La capacité est conservée d'un tick à l'autre
+    }
+
+    // Plusieurs gains de score ou dégâts dans le tick : un seul signal
+    if (m_scoreDirty) {
+        m_scoreDirty = false;
+        emit scoreChanged(m_score);
+    }
+    if (m_healthDirty) {
+        m_healthDirty = false;
+        emit playerHealthChanged(m_player->getHealth());
+    }
+    emit tickCompleted();
+}
+
+void GameEngine::savePreviousPositions() {
+    m_player->savePreviousPosition();
+    if (m_partner) {
+        m_partner->savePreviousPosition();
+    }
+    for (auto& enemy : m_enemies) {
+        enemy->savePreviousPosition();
+    }
+    for (auto& bullet : m_bullets) {
+        bullet->savePreviousPosition();
+    }
+}
+
 void GameEngine::update() {
     if (m_state != GameState::PLAYING) return;
 
-    // Sauvegarder la position actuelle du joueur
-    QPointF oldPlayerPos = m_player->getPosition();
+    ProfileScope tickScope(ProfilePhase::TICK);
 
-    // Mettre à jour le joueur (mouvement interne)
-    m_player->update();
+    // Mémoriser l'état du tick précédent pour l'interpolation du rendu
+    savePreviousPositions();
 
-    // Vérifier si le nouveau mouvement est valide
-    QPointF newPlayerPos = m_player->getPosition();
+    // Entrées reçues depuis le tick précédent, dans leur ordre d'arrivée
+    applyInput();
 
-    // Seulement vérifier les collisions si le joueur a bougé
-    if (newPlayerPos != oldPlayerPos) {
-        if (!isValidMove(m_player->getRect(), m_player.get())) {
-            // Restaurer l'ancienne position si collision
-            m_player->setPosition(oldPlayerPos);
+    {
+        ProfileScope scope(ProfilePhase::PLAYER_UPDATE);
+        updatePlayerTank(*m_player);
+        if (m_partner) {
+            updatePlayerTank(*m_partner);
         }
     }
 
+    // Apparition des ennemis, cadencée en ticks par la vague en cours
+    const int spawnInterval = m_tuning.spawnIntervalTicks > 0 ? m_tuning.spawnIntervalTicks
+                                                               : m_waves[m_waveIndex].spawnIntervalTicks;
+    if (++m_spawnTickCounter >= spawnInterval) {
+        m_spawnTickCounter = 0;
+        spawnEnemy();
+    }
+
     // Mettre à jour les ennemis
-    updateEnemies();
+    {
+        ProfileScope scope(ProfilePhase::UPDATE_ENEMIES);
+        updateEnemies();
+    }
 
     // Mettre à jour les balles (SANS vérification de collision ici)
-    for (auto& bullet : m_bullets) {
-        if (bullet->isActive()) {
-            bullet->update();
+    {
+        ProfileScope scope(ProfilePhase::UPDATE_BULLETS);
+        for (auto& bullet : m_bullets) {
+            if (bullet->isActive()) {
+                bullet->update();
+            }
         }
     }
 
     // Mettre à jour les power-ups
-    for (auto& powerUp : m_powerUps) {
-        if (powerUp->isActive()) {
-            powerUp->update();
+    {
+        ProfileScope scope(ProfilePhase::UPDATE_POWERUPS);
+        for (auto& powerUp : m_powerUps) {
+            if (powerUp->isActive()) {
+                powerUp->update();
+            }
         }
     }
 
     // Vérifier toutes les collisions APRÈS les mouvements
-    checkCollisions();
+    {
+        ProfileScope scope(ProfilePhase::CHECK_COLLISIONS);
+        checkCollisions();
+    }
+
+    // Signaler les zones à repeindre avant de retirer les entités inactives
+    markChangedEntities();
 
     // Nettoyer les entités inactives
-    cleanupInactive();
+    {
+        ProfileScope scope(ProfilePhase::CLEANUP_INACTIVE);
+        cleanupInactive();
+    }
+
+    m_tickCount++;
+
+    // Un seul envoi par tick, avant les changements d'état
+    dispatchEvents();
 
     // Vérifier condition de victoire
     if (m_enemiesRemaining == 0 && m_enemies.empty()) {
         m_state = GameState::LEVEL_COMPLETE;
-        m_gameTimer->stop();
-        m_enemySpawnTimer->stop();
-        emit gameStateChanged(m_state);
+        if (!m_sessionDriven) m_scheduler->stop();
+        prepareNextLevel();
+        if (!m_sessionDriven) emit gameStateChanged(m_state);
         qDebug() << "=== NIVEAU TERMINÉ ===";
         qDebug() << "Score final:" << m_score;
     }
 
-    // Vérifier condition de défaite
-    if (!m_player->isActive() || m_baseDestroyed) {
+    // Vérifier condition de défaite (en coopération : les deux tanks détruits)
+    if (!anyPlayerActive() || m_baseDestroyed) {
         m_state = GameState::GAME_OVER;
-        m_gameTimer->stop();
-        m_enemySpawnTimer->stop();
-        emit gameStateChanged(m_state);
+        if (!m_sessionDriven) {
+            m_scheduler->stop();
+            emit gameStateChanged(m_state);
+        }
         qDebug() << "=== GAME OVER ===";
         qDebug() << "Score final:" << m_score;
     }
 }
 
+void GameEngine::updatePlayerTank(Tank& tank) {
+    // Sauvegarder la position actuelle du joueur
+    const FixedPoint oldPlayerPos = tank.getFixedPosition();
+
+    // Mettre à jour le joueur (mouvement interne) ; toujours un Tank exact
+    tank.Tank::update();
+
+    // Seulement vérifier les collisions si le joueur a bougé
+    if (tank.getFixedPosition() != oldPlayerPos) {
+        if (!isValidMove(tank.getBox(), &tank)) {
+            // Restaurer l'ancienne position si collision
+            tank.setPosition(oldPlayerPos);
+        }
+    }
+}
+
 void GameEngine::updateEnemies() {
     for (auto& enemy : m_enemies) {
         if (!enemy->isActive()) continue;
 
         // Sauvegarder la position actuelle
-        QPointF oldPos = enemy->getPosition();
+        const FixedPoint oldPos = enemy->getFixedPosition();
 
         // Mettre à jour (mouvement interne)
         enemy->update();
 
         // Vérifier si l'ennemi a bougé
-        QPointF newPos = enemy->getPosition();
+        const FixedPoint newPos = enemy->getFixedPosition();
 
         // Seulement vérifier les collisions si mouvement effectué
         if (newPos != oldPos) {
-            if (!isValidMove(enemy->getRect(), enemy.get())) {
+            if (!isValidMove(enemy->getBox(), enemy.get())) {
                 // Restaurer position et forcer changement de direction
                 enemy->setPosition(oldPos);
                 enemy->updateAI();
@@ -212,53 +733,61 @@ void GameEngine::updateEnemies() {
 
         // Tir des ennemis
         if (enemy->shouldShoot() && enemy->canShoot()) {
-            QPointF bulletStartPos = enemy->getRect().center();
+            const FixedRect& box = enemy->getBox();
+            FixedPoint bulletStartPos = box.center();
 
             // Ajuster la position selon la direction du canon
             Direction dir = enemy->getDirection();
             switch (dir) {
             case Direction::UP:
-                bulletStartPos.setY(enemy->getRect().top());
+                bulletStartPos.y = box.top();
                 break;
             case Direction::DOWN:
-                bulletStartPos.setY(enemy->getRect().bottom());
+                bulletStartPos.y = box.bottom();
                 break;
             case Direction::LEFT:
-                bulletStartPos.setX(enemy->getRect().left());
+                bulletStartPos.x = box.left();
                 break;
             case Direction::RIGHT:
-                bulletStartPos.setX(enemy->getRect().right());
+                bulletStartPos.x = box.right();
                 break;
             }
 
             m_bullets.push_back(std::make_unique<Bullet>(bulletStartPos, dir, false));
             enemy->resetShootCooldown();
             enemy->resetShootTimer();
-            emit soundEffect("enemy_shoot");
+            pushEvent(GameEventType::ENEMY_SHOOT, *enemy);
         }
     }
 }
 
-QPointF GameEngine::getSpawnPosition(int index) {
-    int spawnPoints = 3;
-    int spacing = GameConstants::GAME_AREA_WIDTH / (spawnPoints + 1);
-    int x = spacing * ((index % spawnPoints) + 1) - 16;
-    return QPointF(x, 16);
+FixedPoint GameEngine::getSpawnPosition(int index) {
+    int spacing = GameConstants::GAME_AREA_WIDTH / (SPAWN_POINTS + 1);
+    int x = spacing * ((index % SPAWN_POINTS) + 1) - 16;
+    return FixedPoint::fromPixels(x, 16);
 }
 
 void GameEngine::spawnEnemy() {
     if (m_state != GameState::PLAYING) return;
 
-    if (m_activeEnemies < GameConstants::ACTIVE_ENEMIES && m_enemiesRemaining > 0) {
-        QPointF spawnPos = getSpawnPosition(m_activeEnemies);
+    const LevelWave& wave = m_waves[m_waveIndex];
+    if (m_activeEnemies < wave.maxActive && m_enemiesRemaining > 0) {
+        const FixedPoint spawnPos = m_spawnPoints[m_activeEnemies % m_spawnPoints.size()];
 
         // Vérifier que la position de spawn est valide
-        QRectF testRect(spawnPos, QSizeF(28, 28));
+        const FixedRect testRect = FixedRect::square(spawnPos, 28);
         if (isValidMove(testRect)) {
-            m_enemies.push_back(std::make_unique<Enemy>(spawnPos));
+            m_enemies.push_back(std::make_unique<Enemy>(spawnPos, m_random.generate()));
+            markEntityDirty(*m_enemies.back());
             m_enemiesRemaining--;
             m_activeEnemies++;
-            emit soundEffect("enemy_spawn");
+
+            // Vague complète : la suivante prend le relais
+            if (++m_waveSpawned >= wave.enemies && m_waveIndex + 1 < m_waves.size()) {
+                m_waveIndex++;
+                m_waveSpawned = 0;
+            }
+            pushEvent(GameEventType::ENEMY_SPAWN, *m_enemies.back());
             qDebug() << "Ennemi spawné - Restants:" << m_enemiesRemaining
                      << "Actifs:" << m_activeEnemies;
         }
@@ -266,192 +795,313 @@ void GameEngine::spawnEnemy() {
 }
 
 void GameEngine::checkCollisions() {
+    // Joueurs et ennemis modifiés depuis la passe précédente. Les balles
+    // bougent à chaque tick : leurs paires sont toujours testées.
+    for (Tank* player : {m_player.get(), m_partner.get()}) {
+        if (player) player->refreshCollisionState();
+    }
+    m_changedEnemies.clear();
+    for (size_t i = 0; i < m_enemies.size(); i++) {
+        if (m_enemies[i]->refreshCollisionState()) m_changedEnemies.push_back(i);
+    }
+
     checkBulletCollisions();
     checkPowerUpCollisions();
     checkTankCollisions();
 }
 
 void GameEngine::checkTankCollisions() {
-    // Empêcher le joueur de traverser les ennemis
-    if (!m_player->isActive()) return;
+    // Empêcher les joueurs de traverser les ennemis
+    if constexpr (!CollisionLayers::interacts(CollisionLayers::PLAYER_TANK, CollisionLayers::ENEMY_TANK)) return;
+
+    for (Tank* player : {m_player.get(), m_partner.get()}) {
+        if (!player || !player->isActive()) continue;
+
+        // Joueur immobile : seuls les ennemis modifiés peuvent le toucher,
+        // jusqu'à ce qu'une répulsion le déplace
+        size_t next = 0;
+        if (!player->isCollisionDirty()) {
+            for (size_t index : m_changedEnemies) {
+                if (pushPlayerAway(*player, *m_enemies[index])) {
+                    next = index + 1;
+                    break;
+                }
+            }
+            if (!player->isCollisionDirty()) continue;
+        }
 
-    for (auto& enemy : m_enemies) {
-        if (!enemy->isActive()) continue;
+        for (size_t i = next; i < m_enemies.size(); i++) {
+            pushPlayerAway(*player, *m_enemies[i]);
+        }
+    }
+}
 
-        if (m_player->collidesWith(*enemy)) {
-            // Calculer la direction de répulsion
-            QPointF playerPos = m_player->getPosition();
-            QPointF enemyPos = enemy->getPosition();
+bool GameEngine::pushPlayerAway(Tank& player, const Enemy& enemy) {
+    if (!player.collidesWith(enemy)) return false;
 
-            QPointF direction = playerPos - enemyPos;
-            qreal length = qSqrt(direction.x() * direction.x() + direction.y() * direction.y());
+    // Calculer la direction de répulsion (3 pixels, racine entière)
+    const FixedPoint playerPos = player.getFixedPosition();
+    const FixedPoint direction = playerPos - enemy.getFixedPosition();
+    const qint64 length = direction.length();
+    if (length == 0) return false;
 
-            if (length > 0) {
-                direction /= length;
-                m_player->setPosition(playerPos + direction * 3);
-            }
-        }
-    }
+    const qint64 push = Fixed::fromPixels(3);
+    player.setPosition(playerPos + FixedPoint(static_cast<qint32>(direction.x * push / length),
+                                              static_cast<qint32>(direction.y * push / length)));
+    player.markCollisionDirty();
+    return true;
 }
 
 void GameEngine::checkBulletCollisions() {
-    // CORRECTION MAJEURE: Vérifier TOUTES les collisions de balles
-    for (auto& bullet : m_bullets) {
-        if (!bullet->isActive()) continue;
+    // 1. Détection : lecture seule, par tranches de balles, en parallèle
+    //    quand elles sont nombreuses
+    const size_t chunks = (m_bullets.size() + NARROW_PHASE_CHUNK - 1) / NARROW_PHASE_CHUNK;
+    m_narrowPhase.resize(chunks);
+    for (size_t i = 0; i < chunks; i++) {
+        m_narrowPhase[i].first = i * NARROW_PHASE_CHUNK;
+        m_narrowPhase[i].last = std::min(m_bullets.size(), (i + 1) * NARROW_PHASE_CHUNK);
+    }
 
-        bool bulletHit = false;
+    if (m_parallelCollisions && m_bullets.size() >= PARALLEL_NARROW_PHASE_MIN) {
+        QtConcurrent::blockingMap(m_narrowPhase, [this](NarrowPhaseChunk& chunk) {
+            findBulletContacts(chunk);
+        });
+    } else {
+        for (auto& chunk : m_narrowPhase) {
+            findBulletContacts(chunk);
+        }
+    }
 
-        // 1. Collision balle vs blocs
-        for (auto& block : m_blocks) {
-            if (!block->isActive() || bulletHit) continue;
+    // 2. Réponse, en série et dans l'ordre des balles. m_bullets est trié par
+    //    identifiant (ajouts en fin, identifiants croissants) : le résultat ne
+    //    dépend ni du découpage ni du nombre de threads.
+    for (const auto& chunk : m_narrowPhase) {
+        quint32 stopped = std::numeric_limits<quint32>::max();
+        for (const BulletContact& contact : chunk.contacts) {
+            if (contact.kind == BulletContact::BULLET || contact.bullet == stopped) continue;
+            if (applyBulletContact(*m_bullets[contact.bullet], contact)) {
+                stopped = contact.bullet;
+            }
+        }
+    }
 
-            if (bullet->collidesWith(*block)) {
-                Block* blockPtr = static_cast<Block*>(block.get());
+    // 3. Collision balle vs balle, une fois les impacts appliqués
+    for (const auto& chunk : m_narrowPhase) {
+        for (const BulletContact& contact : chunk.contacts) {
+            if (contact.kind != BulletContact::BULLET) continue;
 
-                // Si c'est la base, game over
-                if (blockPtr->getBlockType() == BlockType::BASE) {
-                    m_baseDestroyed = true;
-                    emit soundEffect("base_destroyed");
-                    qDebug() << "!!! BASE DÉTRUITE !!!";
-                }
+            Bullet& first = *m_bullets[contact.bullet];
+            Bullet& second = *m_bullets[contact.other];
+            if (first.isActive() && second.isActive()) {
+                first.setActive(false);
+                second.setActive(false);
+                qDebug() << "Collision balle vs balle";
+            }
+        }
+    }
+}
 
-                // Si destructible, détruire le bloc
-                if (blockPtr->isDestructible()) {
-                    block->setActive(false);
-                    emit soundEffect("block_destroyed");
+void GameEngine::findBulletContacts(NarrowPhaseChunk& chunk) const {
+    chunk.contacts.clear();
+    const Tank* players[2] = {m_player.get(), m_partner.get()};
+
+    for (size_t i = chunk.first; i < chunk.last; i++) {
+        const Bullet& bullet = *m_bullets[i];
+        if (!bullet.isActive()) continue;
+        const quint32 index = static_cast<quint32>(i);
+
+        // Couches touchées par cette balle : les autres paires ne sont pas testées
+        const CollisionLayers::Mask contacts =
+            CollisionLayers::CONTACTS[CollisionLayers::layerOf(EntityType::BULLET, bullet.isFromPlayer())];
+
+        // Blocs, ennemis puis joueurs : la réponse retient le premier encore actif
+        for (size_t b = 0; b < m_blocks.size(); b++) {
+            const Block& block = *m_blocks[b];
+            if (!(contacts & CollisionLayers::bit(CollisionLayers::layerOf(block.getType())))) continue;
+            if (bullet.collidesWith(block)) {
+                chunk.contacts.push_back({index, static_cast<quint32>(b), BulletContact::BLOCK});
+            }
+        }
+
+        if (contacts & CollisionLayers::bit(CollisionLayers::ENEMY_TANK)) {
+            for (size_t e = 0; e < m_enemies.size(); e++) {
+                if (bullet.collidesWith(*m_enemies[e])) {
+                    chunk.contacts.push_back({index, static_cast<quint32>(e), BulletContact::ENEMY});
                 }
+            }
+        }
 
-                // Les arbres ne bloquent pas les balles
-                if (!blockPtr->isCamouflage()) {
-                    bullet->setActive(false);
-                    bulletHit = true;
+        if (contacts & CollisionLayers::bit(CollisionLayers::PLAYER_TANK)) {
+            for (quint32 p = 0; p < 2; p++) {
+                if (players[p] && bullet.collidesWith(*players[p])) {
+                    chunk.contacts.push_back({index, p, BulletContact::PLAYER});
                 }
             }
         }
 
-        if (bulletHit) continue;
+        // Balles suivantes : chaque paire une seule fois
+        for (size_t j = i + 1; j < m_bullets.size(); j++) {
+            const Bullet& other = *m_bullets[j];
+            if (!(contacts & CollisionLayers::bit(CollisionLayers::layerOf(EntityType::BULLET, other.isFromPlayer())))) continue;
+            if (bullet.collidesWith(other)) {
+                chunk.contacts.push_back({index, static_cast<quint32>(j), BulletContact::BULLET});
+            }
+        }
+    }
+}
 
-        // 2. CORRECTION: Collision balles du joueur vs ennemis
-        if (bullet->isFromPlayer()) {
-            for (auto& enemy : m_enemies) {
-                if (!enemy->isActive() || bulletHit) continue;
+bool GameEngine::applyBulletContact(Bullet& bullet, const BulletContact& contact) {
+    switch (contact.kind) {
+    case BulletContact::BLOCK: {
+        // Bloc détruit par une balle précédente de ce tick : contact suivant
+        Block& block = *m_blocks[contact.other];
+        if (!block.isActive()) return false;
+
+        // Si c'est la base, game over
+        if (block.getBlockType() == BlockType::BASE) {
+            m_baseDestroyed = true;
+            pushEvent(GameEventType::BASE_DESTROYED, block);
+            qDebug() << "!!! BASE DÉTRUITE !!!";
+        }
 
-                if (bullet->collidesWith(*enemy)) {
-                    qDebug() << ">>> Balle du joueur touche un ennemi!";
+        // Si destructible, détruire le bloc
+        if (block.isDestructible()) {
+            block.setActive(false);
+            pushEvent(GameEventType::BLOCK_DESTROYED, block);
+        }
 
-                    enemy->takeDamage(1);
-                    bullet->setActive(false);
-                    bulletHit = true;
+        bullet.setActive(false);
+        return true;
+    }
 
-                    if (!enemy->isActive()) {
-                        // Ennemi détruit
-                        m_score += GameConstants::ENEMY_KILL_SCORE;
-                        m_activeEnemies--;
-                        emit scoreChanged(m_score);
-                        emit soundEffect("enemy_destroyed");
+    case BulletContact::ENEMY: {
+        Enemy& enemy = *m_enemies[contact.other];
+        if (!enemy.isActive()) return false;
 
-                        qDebug() << "*** ENNEMI DÉTRUIT ***";
-                        qDebug() << "Score:" << m_score;
-                        qDebug() << "Ennemis actifs restants:" << m_activeEnemies;
-                        qDebug() << "Ennemis à spawner:" << m_enemiesRemaining;
+        qDebug() << ">>> Balle du joueur touche un ennemi!";
 
-                        // Chance de drop power-up (30%)
-                        if (QRandomGenerator::global()->bounded(100) < 30) {
-                            spawnPowerUp(enemy->getPosition());
-                        }
-                    }
-                    break;
-                }
-            }
-        }
-        // 3. Collision balles ennemies vs joueur
-        else {
-            if (m_player->isActive() && !bulletHit) {
-                if (bullet->collidesWith(*m_player)) {
-                    qDebug() << "<<< Balle ennemie touche le joueur!";
+        enemy.takeDamage(1);
+        bullet.setActive(false);
 
-                    m_player->takeDamage(1);
-                    bullet->setActive(false);
-                    bulletHit = true;
+        if (!enemy.isActive()) {
+            // Ennemi détruit
+            m_score += GameConstants::ENEMY_KILL_SCORE;
+            m_activeEnemies--;
+            m_scoreDirty = true;
+            pushEvent(GameEventType::ENEMY_DESTROYED, enemy);
 
-                    emit playerHealthChanged(m_player->getHealth());
-                    emit soundEffect("player_hit");
+            qDebug() << "*** ENNEMI DÉTRUIT ***";
+            qDebug() << "Score:" << m_score;
+            qDebug() << "Ennemis actifs restants:" << m_activeEnemies;
+            qDebug() << "Ennemis à spawner:" << m_enemiesRemaining;
 
-                    qDebug() << "Santé joueur:" << m_player->getHealth();
-                }
+            // Chance de drop power-up (30% par défaut)
+            if (static_cast<int>(m_random.bounded(100)) < m_tuning.powerUpDropPercent) {
+                spawnPowerUp(enemy.getFixedPosition());
             }
         }
+        return true;
     }
 
-    // 4. Collision balle vs balle
-    for (size_t i = 0; i < m_bullets.size(); i++) {
-        if (!m_bullets[i]->isActive()) continue;
+    case BulletContact::PLAYER: {
+        Tank* player = contact.other == 0 ? m_player.get() : m_partner.get();
+        if (!player->isActive()) return false;
 
-        for (size_t j = i + 1; j < m_bullets.size(); j++) {
-            if (!m_bullets[j]->isActive()) continue;
+        qDebug() << "<<< Balle ennemie touche le joueur!";
 
-            if (m_bullets[i]->collidesWith(*m_bullets[j])) {
-                m_bullets[i]->setActive(false);
-                m_bullets[j]->setActive(false);
-                qDebug() << "Collision balle vs balle";
-            }
-        }
+        player->takeDamage(1);
+        bullet.setActive(false);
+
+        m_healthDirty = true;
+        pushEvent(GameEventType::PLAYER_HIT, *player);
+
+        qDebug() << "Santé joueur:" << player->getHealth();
+        return true;
+    }
+
+    case BulletContact::BULLET:
+        break;
     }
+    return false;
 }
 
 void GameEngine::checkPowerUpCollisions() {
-    if (!m_player->isActive()) return;
+    if constexpr (!CollisionLayers::interacts(CollisionLayers::POWERUP, CollisionLayers::PLAYER_TANK)) return;
 
-    for (auto& powerUp : m_powerUps) {
-        if (!powerUp->isActive()) continue;
+    // Après les balles : les power-ups lâchés pendant ce tick sont neufs, donc modifiés
+    m_changedPowerUps.clear();
+    for (size_t i = 0; i < m_powerUps.size(); i++) {
+        if (m_powerUps[i]->refreshCollisionState()) m_changedPowerUps.push_back(i);
+    }
 
-        if (powerUp->collidesWith(*m_player)) {
-            PowerUp* powerUpPtr = static_cast<PowerUp*>(powerUp.get());
+    // Joueurs immobiles : seuls les power-ups modifiés peuvent être ramassés
+    const bool playerMoved = m_player->isCollisionDirty() || (m_partner && m_partner->isCollisionDirty());
+    if (playerMoved) {
+        for (size_t i = 0; i < m_powerUps.size(); i++) {
+            collectPowerUp(*m_powerUps[i]);
+        }
+    } else {
+        for (size_t index : m_changedPowerUps) {
+            collectPowerUp(*m_powerUps[index]);
+        }
+    }
+}
 
-            switch (powerUpPtr->getPowerUpType()) {
-            case PowerUpType::HEALTH:
-                m_player->heal(1);
-                emit playerHealthChanged(m_player->getHealth());
-                emit soundEffect("powerup_health");
-                qDebug() << "❤️ Power-up SANTÉ collecté - Santé:" << m_player->getHealth();
-                break;
+void GameEngine::collectPowerUp(PowerUp& powerUp) {
+    if (!powerUp.isActive()) return;
 
-            case PowerUpType::BOMB:
-                triggerBomb();
-                emit soundEffect("powerup_bomb");
-                qDebug() << "💣 BOMBE activée!";
-                break;
+    // Le premier joueur au contact ramasse le power-up
+    Tank* collector = nullptr;
+    for (Tank* player : {m_player.get(), m_partner.get()}) {
+        if (player && player->isActive() && powerUp.collidesWith(*player)) {
+            collector = player;
+            break;
+        }
+    }
+    if (!collector) return;
+
+    switch (powerUp.getPowerUpType()) {
+    case PowerUpType::HEALTH:
+        collector->heal(1);
+        m_healthDirty = true;
+        pushEvent(GameEventType::POWERUP_HEALTH, powerUp);
+        qDebug() << "❤️ Power-up SANTÉ collecté - Santé:" << collector->getHealth();
+        break;
 
-            case PowerUpType::SHIELD:
-                m_player->activateShield(300);
-                emit soundEffect("powerup_shield");
-                qDebug() << "🛡️ BOUCLIER activé";
-                break;
-            }
+    case PowerUpType::BOMB:
+        triggerBomb();
+        pushEvent(GameEventType::POWERUP_BOMB, powerUp);
+        qDebug() << "💣 BOMBE activée!";
+        break;
 
-            powerUp->setActive(false);
-            m_score += 50;
-            emit scoreChanged(m_score);
-        }
+    case PowerUpType::SHIELD:
+        collector->activateShield(300);
+        pushEvent(GameEventType::POWERUP_SHIELD, powerUp);
+        qDebug() << "🛡️ BOUCLIER activé";
+        break;
     }
+
+    powerUp.setActive(false);
+    m_score += 50;
+    m_scoreDirty = true;
 }
 
-void GameEngine::spawnPowerUp(const QPointF& position) {
-    QPointF pos = position;
+void GameEngine::spawnPowerUp(const FixedPoint& position) {
+    FixedPoint pos = position;
 
     // Si pas de position fournie, chercher une position aléatoire valide
-    if (pos.isNull()) {
+    if (pos == FixedPoint()) {
         bool validPos = false;
         int attempts = 0;
 
         while (!validPos && attempts < 50) {
-            int x = QRandomGenerator::global()->bounded(GameConstants::GRID_WIDTH) *
+            int x = m_random.bounded(GameConstants::GRID_WIDTH) *
                     GameConstants::CELL_SIZE;
-            int y = QRandomGenerator::global()->bounded(GameConstants::GRID_HEIGHT) *
+            int y = m_random.bounded(GameConstants::GRID_HEIGHT) *
                     GameConstants::CELL_SIZE;
-            pos = QPointF(x, y);
+            pos = FixedPoint::fromPixels(x, y);
 
-            QRectF testRect(pos, QSizeF(24, 24));
+            const FixedRect testRect = FixedRect::square(pos, 24);
             validPos = isValidMove(testRect);
             attempts++;
         }
@@ -463,7 +1113,7 @@ void GameEngine::spawnPowerUp(const QPointF& position) {
     }
 
     // Choisir un type de power-up aléatoire
-    int powerUpChoice = QRandomGenerator::global()->bounded(3);
+    int powerUpChoice = m_random.bounded(3);
     PowerUpType type;
 
     switch (powerUpChoice) {
@@ -474,7 +1124,8 @@ void GameEngine::spawnPowerUp(const QPointF& position) {
     }
 
     m_powerUps.push_back(std::make_unique<PowerUp>(pos, type));
-    qDebug() << "✨ Power-up spawné à" << pos;
+    markEntityDirty(*m_powerUps.back());
+    qDebug() << "✨ Power-up spawné à" << pos.toPointF();
 }
 
 void GameEngine::triggerBomb() {
@@ -490,15 +1141,15 @@ void GameEngine::triggerBomb() {
     }
 
     if (destroyed > 0) {
-        emit scoreChanged(m_score);
+        m_scoreDirty = true;
         qDebug() << "💥 BOMBE:" << destroyed << "ennemis détruits! Score:" << m_score;
     }
 }
 
-bool GameEngine::isValidMove(const QRectF& rect, Entity* ignore) {
+bool GameEngine::isValidMove(const FixedRect& rect, Entity* ignore) {
     // Vérifier les limites du terrain
-    if (rect.left() < 0 || rect.right() > GameConstants::GAME_AREA_WIDTH ||
-        rect.top() < 0 || rect.bottom() > GameConstants::GAME_AREA_HEIGHT) {
+    if (rect.left() < 0 || rect.right() > Fixed::fromPixels(GameConstants::GAME_AREA_WIDTH) ||
+        rect.top() < 0 || rect.bottom() > Fixed::fromPixels(GameConstants::GAME_AREA_HEIGHT)) {
         return false;
     }
 
@@ -506,17 +1157,13 @@ bool GameEngine::isValidMove(const QRectF& rect, Entity* ignore) {
     for (const auto& block : m_blocks) {
         if (!block->isActive() || block.get() == ignore) continue;
 
-        Block* blockPtr = static_cast<Block*>(block.get());
-
         // Les arbres ne bloquent pas le mouvement
-        if (blockPtr->blocksMovement()) {
+        if (CollisionLayers::blocksMovement(CollisionLayers::layerOf(block->getType()))) {
             // Vérifier intersection avec une petite marge
-            if (rect.intersects(block->getRect())) {
+            if (rect.intersects(block->getBox())) {
                 // Si c'est le joueur au spawn initial, autoriser quand même
                 if (ignore == m_player.get()) {
-                    QPointF playerSpawn(GameConstants::GAME_AREA_WIDTH / 2 - 14,
-                                        GameConstants::GAME_AREA_HEIGHT - 50);
-                    QRectF spawnArea(playerSpawn.x() - 5, playerSpawn.y() - 5, 38, 38);
+                    const FixedRect spawnArea = FixedRect::square(m_playerStart - FixedPoint::fromPixels(5, 5), 38);
 
                     // Si on est proche du spawn, autoriser
                     if (spawnArea.intersects(rect)) {
@@ -530,7 +1177,12 @@ bool GameEngine::isValidMove(const QRectF& rect, Entity* ignore) {
 
     // Vérifier collision avec le joueur
     if (m_player.get() != ignore && m_player->isActive()) {
-        if (rect.intersects(m_player->getRect())) {
+        if (rect.intersects(m_player->getBox())) {
+            return false;
+        }
+    }
+    if (m_partner && m_partner.get() != ignore && m_partner->isActive()) {
+        if (rect.intersects(m_partner->getBox())) {
             return false;
         }
     }
@@ -538,7 +1190,7 @@ bool GameEngine::isValidMove(const QRectF& rect, Entity* ignore) {
     // Vérifier collision avec les autres ennemis
     for (const auto& enemy : m_enemies) {
         if (enemy.get() != ignore && enemy->isActive()) {
-            if (rect.intersects(enemy->getRect())) {
+            if (rect.intersects(enemy->getBox())) {
                 return false;
             }
         }
@@ -589,55 +1241,132 @@ void GameEngine::cleanupInactive() {
 }
 
 void GameEngine::processInput(int key, bool pressed) {
-    if (m_state != GameState::PLAYING || !m_player) return;
-
     switch (key) {
     case Qt::Key_W:
     case Qt::Key_Up:
-        m_player->setMoving(Direction::UP, pressed);
+        submitInput(InputAction::MOVE_UP, pressed);
         break;
     case Qt::Key_S:
     case Qt::Key_Down:
-        m_player->setMoving(Direction::DOWN, pressed);
+        submitInput(InputAction::MOVE_DOWN, pressed);
         break;
     case Qt::Key_A:
     case Qt::Key_Left:
-        m_player->setMoving(Direction::LEFT, pressed);
+        submitInput(InputAction::MOVE_LEFT, pressed);
         break;
     case Qt::Key_D:
     case Qt::Key_Right:
-        m_player->setMoving(Direction::RIGHT, pressed);
+        submitInput(InputAction::MOVE_RIGHT, pressed);
         break;
     }
 }
 
 void GameEngine::playerShoot() {
-    if (m_state != GameState::PLAYING || !m_player || !m_player->canShoot()) {
+    submitInput(InputAction::SHOOT, true);
+}
+
+void GameEngine::submitInput(InputAction action, bool pressed) {
+    submitInput(InputEvent{action, pressed});
+}
+
+void GameEngine::submitInput(const InputEvent& event) {
+    // Les relâchements restent en file pendant une pause : la touche
+    // ne doit pas rester enfoncée à la reprise
+    if (event.action == InputAction::SHOOT && m_state != GameState::PLAYING) return;
+    m_input.push(event);
+}
+
+void GameEngine::applyInput() {
+    m_input.takeAll(m_tickInput);
+
+    // Relâchements reportés : l'appui bref a eu son tick
+    for (const InputEvent& event : m_carriedInput) {
+        applyInputEvent(event);
+    }
+    m_carriedInput.clear();
+
+    for (size_t i = 0; i < m_tickInput.size(); i++) {
+        const InputEvent& event = m_tickInput[i];
+
+        if (event.pressed) {
+            // Nouvel appui : un relâchement reporté de la même touche est caduc
+            m_carriedInput.erase(std::remove_if(m_carriedInput.begin(), m_carriedInput.end(),
+                                                [&event](const InputEvent& carried) {
+                                                    return carried.action == event.action &&
+                                                           carried.player == event.player;
+                                                }),
+                                 m_carriedInput.end());
+            applyInputEvent(event);
+            continue;
+        }
+
+        // Appui et relâchement dans le même tick : le relâchement attend le
+        // tick suivant, sinon un appui plus court qu'un tick serait perdu
+        const bool pressedThisTick = std::any_of(m_tickInput.begin(), m_tickInput.begin() + i,
+                                                 [&event](const InputEvent& earlier) {
+                                                     return earlier.action == event.action &&
+                                                            earlier.player == event.player && earlier.pressed;
+                                                 });
+        if (pressedThisTick) {
+            m_carriedInput.push_back(event);
+        } else {
+            applyInputEvent(event);
+        }
+    }
+}
+
+void GameEngine::applyInputEvent(const InputEvent& event) {
+    Tank* tank = event.player == 0 ? m_player.get() : m_partner.get();
+    if (!tank) return;
+
+    switch (event.action) {
+    case InputAction::MOVE_UP:
+        tank->setMoving(Direction::UP, event.pressed);
+        break;
+    case InputAction::MOVE_DOWN:
+        tank->setMoving(Direction::DOWN, event.pressed);
+        break;
+    case InputAction::MOVE_LEFT:
+        tank->setMoving(Direction::LEFT, event.pressed);
+        break;
+    case InputAction::MOVE_RIGHT:
+        tank->setMoving(Direction::RIGHT, event.pressed);
+        break;
+    case InputAction::SHOOT:
+        firePlayerBullet(*tank);
+        break;
+    }
+}
+
+void GameEngine::firePlayerBullet(Tank& tank) {
+    if (!tank.isActive() || !tank.canShoot()) {
         return;
     }
 
     // Calculer la position de départ de la balle selon la direction du canon
-    QPointF bulletStartPos = m_player->getRect().center();
-    Direction dir = m_player->getDirection();
+    const FixedRect& box = tank.getBox();
+    FixedPoint bulletStartPos = box.center();
+    Direction dir = tank.getDirection();
 
     switch (dir) {
     case Direction::UP:
-        bulletStartPos.setY(m_player->getRect().top());
+        bulletStartPos.y = box.top();
         break;
     case Direction::DOWN:
-        bulletStartPos.setY(m_player->getRect().bottom());
+        bulletStartPos.y = box.bottom();
         break;
     case Direction::LEFT:
-        bulletStartPos.setX(m_player->getRect().left());
+        bulletStartPos.x = box.left();
         break;
     case Direction::RIGHT:
-        bulletStartPos.setX(m_player->getRect().right());
+        bulletStartPos.x = box.right();
         break;
     }
 
     m_bullets.push_back(std::make_unique<Bullet>(bulletStartPos, dir, true));
-    m_player->resetShootCooldown();
-    emit soundEffect("player_shoot");
+    markEntityDirty(*m_bullets.back());
+    tank.resetShootCooldown();
+    pushEvent(GameEventType::PLAYER_SHOOT, tank);
 
     qDebug() << "🔫 Joueur tire - Direction:" << static_cast<int>(dir)
              << "| Balles totales:" << m_bullets.size();
@@ -646,8 +1375,7 @@ void GameEngine::playerShoot() {
 void GameEngine::pauseGame() {
     if (m_state == GameState::PLAYING) {
         m_state = GameState::PAUSED;
-        m_gameTimer->stop();
-        m_enemySpawnTimer->stop();
+        m_scheduler->stop();
         emit gameStateChanged(m_state);
         qDebug() << "⏸️ Jeu en pause";
     }
@@ -656,8 +1384,8 @@ void GameEngine::pauseGame() {
 void GameEngine::resumeGame() {
     if (m_state == GameState::PAUSED) {
         m_state = GameState::PLAYING;
-        m_gameTimer->start();
-        m_enemySpawnTimer->start();
+        // Ne pas compter la durée de la pause dans l'accumulateur
+        m_scheduler->resume();
         emit gameStateChanged(m_state);
         qDebug() << "▶️ Jeu repris";
     }
@@ -669,8 +1397,8 @@ void GameEngine::restartGame() {
 }
 
 void GameEngine::quitToMenu() {
-    m_gameTimer->stop();
-    m_enemySpawnTimer->stop();
+    m_scheduler->stop();
+    m_nextLevel = QFuture<std::shared_ptr<PreparedLevel>>();
     m_state = GameState::MENU;
     emit gameStateChanged(m_state);
     qDebug() << "🏠 Retour au menu";
@@ -1,35 +1,323 @@
 #include "../include/GameWidget.hpp"
 #include "../include/Constants.hpp"
+#include "../include/SaveManager.hpp"
+#include "../include/Profiler.hpp"
 #include <QPainter>
 #include <QFont>
+#include <QScreen>
+#include <QDir>
+#include <QDateTime>
+#include <QStandardPaths>
 
 GameWidget::GameWidget(GameEngine* engine, QWidget* parent)
     : QWidget(parent)
     , m_engine(engine)
+    , m_alpha(1.0)
+    , m_lastTick(0)
+    , m_showProfiler(false)
 {
-    setFixedSize(GameConstants::GAME_AREA_WIDTH, GameConstants::GAME_AREA_HEIGHT);
+    setFixedSize(GameConstants::GAME_AREA_WIDTH, GameConstants::WINDOW_HEIGHT);
     setFocusPolicy(Qt::StrongFocus);
+
+    // Intitulés du HUD : préparés une fois pour toutes
+    m_hudTitleFont = font();
+    m_hudTitleFont.setPixelSize(14);
+    m_hudValueFont = font();
+    m_hudValueFont.setPixelSize(24);
+    m_hudValueFont.setBold(true);
+
+    const char* titles[4] = {"Health", "Score", "Level", "Enemies"};
+    for (int i = 0; i < 4; i++) {
+        m_hudTitles[i].setText(titles[i]);
+        m_hudTitles[i].setTextFormat(Qt::PlainText);
+        m_hudTitles[i].prepare(QTransform(), m_hudTitleFont);
+    }
+    for (QStaticText* value : {&m_hudScore, &m_hudLevel, &m_hudEnemies, &m_hudHealth}) {
+        value->setTextFormat(Qt::PlainText);
+        value->setPerformanceHint(QStaticText::AggressiveCaching);
+    }
+
+    // Le fond est entièrement peint par paintEvent
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    // Repaints partiels à chaque frame, complets à chaque changement d'état
+    connect(m_engine, &GameEngine::frameAdvanced, this, &GameWidget::onFrameAdvanced);
+    connect(m_engine, &GameEngine::gameStateChanged, this, [this]() {
+        refreshHud();
+        update();
+    });
+
+    setSoftwareRendering(SaveManager::instance().getSoftwareRendering());
+}
+
+void GameWidget::setSoftwareRendering(bool enabled) {
+    if (enabled && !m_softwareRenderer) {
+        m_softwareRenderer = std::make_unique<SoftwareRenderer>();
+    } else if (!enabled) {
+        m_softwareRenderer.reset();
+    }
+    update();
+}
+
+void GameWidget::onFrameAdvanced() {
+    const QRegion fresh = m_engine->takeDirtyRegion();
+    const quint64 tick = m_engine->getTickCount();
+
+    if (tick != m_lastTick) {
+        m_previousTickRegion = m_lastTickRegion;
+        m_lastTickRegion = fresh;
+        m_lastTick = tick;
+    } else {
+        m_lastTickRegion += fresh;
+    }
+
+    QRegion region = m_lastTickRegion + m_previousTickRegion;
+    // Les signaux de score et de vie du tick sont ignorés : une relecture par frame suffit
+    if (refreshHud()) {
+        region += hudRect();
+    }
+    if (m_showProfiler) {
+        region += profilerOverlayRect();
+    }
+    if (region.rectCount() > GameConstants::MAX_DIRTY_RECTS) {
+        update();
+    } else if (!region.isEmpty()) {
+        update(region);
+    }
+}
+
+bool GameWidget::needsRepaint(const QRectF& bounds) const {
+    return m_paintRegion.intersects(bounds.toAlignedRect());
+}
+
+void GameWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+
+    // Caler les frames sur la fréquence réelle de l'écran (120/144 Hz inclus)
+    if (QScreen* currentScreen = screen()) {
+        m_engine->setDisplayRefreshRate(currentScreen->refreshRate());
+    }
 }
 
 void GameWidget::paintEvent(QPaintEvent* event) {
-    Q_UNUSED(event);
-    
+    m_alpha = m_engine->getInterpolationAlpha();
+    m_paintRegion = event->region();
+
     QPainter painter(this);
+    painter.setClipRegion(m_paintRegion);
+
+    {
+        ProfileScope scope(ProfilePhase::PAINT);
+        renderFrame(painter);
+
+        if (m_paintRegion.intersects(hudRect())) {
+            renderHud(painter);
+        }
+    }
+
+    if (m_showProfiler) {
+        renderProfilerOverlay(painter);
+    }
+}
+
+void GameWidget::renderFrame(QPainter& painter) {
+    if (m_softwareRenderer) {
+        renderSoftware(painter);
+        return;
+    }
+
     painter.setRenderHint(QPainter::Antialiasing);
     
-    // Draw background
-    painter.fillRect(rect(), QColor(Colors::BACKGROUND));
+    // Draw background (only the dirty rectangles)
+    const QColor background(Colors::BACKGROUND);
+    for (const QRect& dirtyRect : m_paintRegion) {
+        painter.fillRect(dirtyRect, background);
+    }
     
-    if (m_engine->getState() == GameState::PLAYING) {
-        renderGame(painter);
-    } else if (m_engine->getState() == GameState::PAUSED) {
-        renderGame(painter);
+    const GameState state = m_engine->getState();
+    if (state == GameState::MENU) {
+        return;
+    }
+
+    renderGame(painter);
+
+    if (state != GameState::PLAYING) {
+        painter.fillRect(gameAreaRect(), overlayColor(state));
+        renderOverlayText(painter, state);
+    }
+}
+
+void GameWidget::renderSoftware(QPainter& painter) {
+    const GameState state = m_engine->getState();
+
+    if (state == GameState::MENU) {
+        m_softwareRenderer->clear(m_paintRegion);
+    } else {
+        m_softwareRenderer->render(*m_engine, m_alpha, m_paintRegion);
+    }
+
+    if (state != GameState::MENU && state != GameState::PLAYING) {
+        m_softwareRenderer->dim(m_paintRegion, overlayColor(state));
+
+        // Le texte reste dessiné par QPainter, directement dans le framebuffer
+        QPainter framePainter(&m_softwareRenderer->framebuffer());
+        framePainter.setClipRegion(m_paintRegion);
+        renderOverlayText(framePainter, state);
+    }
+
+    // Une seule copie du framebuffer vers l'écran, limitée par le clip
+    painter.drawImage(0, 0, m_softwareRenderer->framebuffer());
+}
+
+QRect GameWidget::gameAreaRect() const {
+    return QRect(0, 0, GameConstants::GAME_AREA_WIDTH, GameConstants::GAME_AREA_HEIGHT);
+}
+
+QRect GameWidget::hudRect() const {
+    return QRect(0, GameConstants::GAME_AREA_HEIGHT, GameConstants::GAME_AREA_WIDTH, GameConstants::HUD_HEIGHT);
+}
+
+bool GameWidget::refreshHud() {
+    HudValues values;
+    values.health = m_engine->getPlayer() ? m_engine->getPlayer()->getHealth() : 0;
+    values.score = m_engine->getScore();
+    values.level = m_engine->getLevel();
+    values.enemies = m_engine->getEnemiesRemaining() + static_cast<int>(m_engine->getEnemies().size());
+
+    bool changed = false;
+    auto refresh = [this, &changed](int value, int& cached, QStaticText& text, const QString& label) {
+        if (value == cached) return;
+        cached = value;
+        text.setText(label);
+        text.prepare(QTransform(), m_hudValueFont);
+        changed = true;
+    };
+
+    refresh(values.health, m_hud.health, m_hudHealth,
+            QString("%1 / %2").arg(values.health).arg(GameConstants::MAX_PLAYER_HEALTH));
+    refresh(values.score, m_hud.score, m_hudScore, QString::number(values.score));
+    refresh(values.level, m_hud.level, m_hudLevel, QString::number(values.level));
+    refresh(values.enemies, m_hud.enemies, m_hudEnemies, QString::number(values.enemies));
+    return changed;
+}
+
+void GameWidget::renderHud(QPainter& painter) {
+    const QRect area = hudRect();
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.fillRect(area, QColor(Colors::HUD_BACKGROUND));
+
+    // Colonnes 2:1:1:1 comme l'ancien HUDWidget
+    const int margin = 10;
+    const int unit = (area.width() - 2 * margin) / 5;
+    const int columns[4] = {margin, margin + 2 * unit, margin + 3 * unit, margin + 4 * unit};
+    const int titleY = area.top() + 10;
+    const int valueY = area.top() + 34;
+
+    painter.setFont(m_hudTitleFont);
+    painter.setPen(QColor(Colors::HUD_TITLE));
+    for (int i = 0; i < 4; i++) {
+        painter.drawStaticText(columns[i], titleY, m_hudTitles[i]);
+    }
+
+    // Barre de vie : une case par point de vie
+    const int cellWidth = 28;
+    for (int i = 0; i < GameConstants::MAX_PLAYER_HEALTH; i++) {
+        const QRect cell(columns[0] + i * (cellWidth + 4), valueY + 4, cellWidth, 20);
+        painter.fillRect(cell, i < m_hud.health ? QColor(Colors::ENEMY_TANK) : QColor(Colors::STEEL_BLOCK));
+    }
+
+    painter.setFont(m_hudValueFont);
+    painter.setPen(Qt::white);
+    painter.drawStaticText(columns[0] + GameConstants::MAX_PLAYER_HEALTH * (cellWidth + 4) + 8, valueY, m_hudHealth);
+    painter.drawStaticText(columns[1], valueY, m_hudScore);
+    painter.drawStaticText(columns[2], valueY, m_hudLevel);
+    painter.drawStaticText(columns[3], valueY, m_hudEnemies);
+
+    painter.restore();
+}
+
+QRect GameWidget::profilerOverlayRect() const {
+    return QRect(8, 8, Profiler::FRAME_HISTORY + 16, PROFILER_GRAPH_HEIGHT + 56);
+}
+
+void GameWidget::renderProfilerOverlay(QPainter& painter) {
+    static const QColor phaseColors[PROFILE_PHASE_COUNT] = {
+        QColor(0, 0, 0, 0),          // TICK : englobe les phases suivantes
+        QColor(100, 180, 255),       // PLAYER_UPDATE
+        QColor(255, 140, 60),        // UPDATE_ENEMIES
+        QColor(255, 230, 80),        // UPDATE_BULLETS
+        QColor(200, 120, 255),       // UPDATE_POWERUPS
+        QColor(255, 70, 70),         // CHECK_COLLISIONS
+        QColor(150, 150, 150),       // CLEANUP_INACTIVE
+        QColor(80, 220, 120)         // PAINT
+    };
+
+    const QRect area = profilerOverlayRect();
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.fillRect(area, QColor(0, 0, 0, 190));
+
+    // Histogramme empilé : une colonne par frame, de la plus ancienne à droite
+    const Profiler& profiler = Profiler::instance();
+    const qreal pixelsPerMs = PROFILER_GRAPH_HEIGHT / PROFILER_GRAPH_MS;
+    const int baseline = area.top() + 8 + PROFILER_GRAPH_HEIGHT;
+    const int count = profiler.frameCount();
+    const int left = area.left() + 8 + Profiler::FRAME_HISTORY - count;
+
+    for (int i = 0; i < count; i++) {
+        const FrameProfile& frame = profiler.frameAt(i);
+        qreal y = baseline;
+        for (int phase = 1; phase < PROFILE_PHASE_COUNT && y > baseline - PROFILER_GRAPH_HEIGHT; phase++) {
+            const qreal height = frame.phaseNs[phase] / 1.0e6 * pixelsPerMs;
+            if (height <= 0) continue;
+            painter.fillRect(QRectF(left + i, y - height, 1, height), phaseColors[phase]);
+            y -= height;
+        }
+    }
+
+    // Budget d'une frame à 60 Hz
+    const int budgetY = baseline - qRound(1000.0 / GameConstants::SIMULATION_RATE * pixelsPerMs);
+    painter.setPen(QPen(QColor(255, 255, 255, 160), 1, Qt::DashLine));
+    painter.drawLine(area.left() + 8, budgetY, area.right() - 8, budgetY);
+
+    // Légende
+    QFont font = painter.font();
+    font.setPixelSize(10);
+    painter.setFont(font);
+    const int legendY = baseline + 6;
+    for (int phase = 1; phase < PROFILE_PHASE_COUNT; phase++) {
+        const int x = area.left() + 8 + (phase - 1) % 3 * 80;
+        const int y = legendY + (phase - 1) / 3 * 14;
+        painter.fillRect(QRect(x, y, 8, 8), phaseColors[phase]);
+        painter.setPen(Qt::white);
+        painter.drawText(QPoint(x + 11, y + 8), Profiler::phaseName(static_cast<ProfilePhase>(phase)));
+    }
+
+    painter.restore();
+}
+
+void GameWidget::exportProfilerTrace() {
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(directory);
+    const QString fileName = QString("trace_%1.json")
+                             .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    Profiler::instance().writeChromeTrace(QDir(directory).filePath(fileName));
+}
+
+QColor GameWidget::overlayColor(GameState state) const {
+    if (state == GameState::GAME_OVER) {
+        return QColor(0, 0, 0, 200);
+    }
+    return QColor(0, 0, 0, 180);
+}
+
+void GameWidget::renderOverlayText(QPainter& painter, GameState state) {
+    if (state == GameState::PAUSED) {
         renderPauseScreen(painter);
-    } else if (m_engine->getState() == GameState::GAME_OVER) {
-        renderGame(painter);
+    } else if (state == GameState::GAME_OVER) {
         renderGameOverScreen(painter);
-    } else if (m_engine->getState() == GameState::LEVEL_COMPLETE) {
-        renderGame(painter);
+    } else if (state == GameState::LEVEL_COMPLETE) {
         renderLevelCompleteScreen(painter);
     }
 }
@@ -41,9 +329,27 @@ void GameWidget::renderGame(QPainter& painter) {
     renderTanks(painter);
 }
 
+template <typename T>
+void GameWidget::renderInterpolated(QPainter& painter, T& entity) {
+    // Bornes couvrant tout le trajet interpolé depuis le tick précédent ;
+    // appels qualifiés : chaque conteneur du moteur n'a qu'un type exact
+    const QRectF bounds = entity.T::getRenderBounds();
+    if (!needsRepaint(bounds.united(bounds.translated(entity.getPreviousPosition() - entity.getPosition())))) {
+        return;
+    }
+
+    // Décaler le dessin entre la position du tick précédent et la position courante
+    const QPointF offset = entity.getInterpolatedPosition(m_alpha) - entity.getPosition();
+
+    painter.save();
+    painter.translate(offset);
+    entity.T::render(painter);
+    painter.restore();
+}
+
 void GameWidget::renderBlocks(QPainter& painter) {
     for (const auto& block : m_engine->getBlocks()) {
-        if (block->isActive()) {
+        if (block->isActive() && needsRepaint(block->getRenderBounds())) {
             block->render(painter);
         }
     }
@@ -53,27 +359,30 @@ void GameWidget::renderTanks(QPainter& painter) {
     // Render enemies
     for (const auto& enemy : m_engine->getEnemies()) {
         if (enemy->isActive()) {
-            enemy->render(painter);
+            renderInterpolated(painter, *enemy);
         }
     }
     
-    // Render player on top
+    // Render players on top
+    if (m_engine->getPartner() && m_engine->getPartner()->isActive()) {
+        renderInterpolated(painter, *m_engine->getPartner());
+    }
     if (m_engine->getPlayer() && m_engine->getPlayer()->isActive()) {
-        m_engine->getPlayer()->render(painter);
+        renderInterpolated(painter, *m_engine->getPlayer());
     }
 }
 
 void GameWidget::renderBullets(QPainter& painter) {
     for (const auto& bullet : m_engine->getBullets()) {
         if (bullet->isActive()) {
-            bullet->render(painter);
+            renderInterpolated(painter, *bullet);
         }
     }
 }
 
 void GameWidget::renderPowerUps(QPainter& painter) {
     for (const auto& powerUp : m_engine->getPowerUps()) {
-        if (powerUp->isActive()) {
+        if (powerUp->isActive() && needsRepaint(powerUp->getRenderBounds())) {
             powerUp->render(painter);
         }
     }
@@ -82,9 +391,6 @@ void GameWidget::renderPowerUps(QPainter& painter) {
 void GameWidget::renderPauseScreen(QPainter& painter) {
     painter.save();
     
-    // Semi-transparent overlay
-    painter.fillRect(rect(), QColor(0, 0, 0, 180));
-    
     // Pause text
     painter.setPen(Qt::white);
     QFont font = painter.font();
@@ -92,13 +398,13 @@ void GameWidget::renderPauseScreen(QPainter& painter) {
     font.setBold(true);
     painter.setFont(font);
     
-    painter.drawText(rect(), Qt::AlignCenter, "PAUSED");
+    painter.drawText(gameAreaRect(), Qt::AlignCenter, "PAUSED");
     
     font.setPixelSize(20);
     font.setBold(false);
     painter.setFont(font);
     
-    QRect textRect = rect().adjusted(0, 80, 0, 0);
+    QRect textRect = gameAreaRect().adjusted(0, 80, 0, 0);
     painter.drawText(textRect, Qt::AlignCenter, "Press ESC to resume\nPress Q to quit");
     
     painter.restore();
@@ -107,26 +413,24 @@ void GameWidget::renderPauseScreen(QPainter& painter) {
 void GameWidget::renderGameOverScreen(QPainter& painter) {
     painter.save();
     
-    painter.fillRect(rect(), QColor(0, 0, 0, 200));
-    
     painter.setPen(QColor(255, 50, 50));
     QFont font = painter.font();
     font.setPixelSize(56);
     font.setBold(true);
     painter.setFont(font);
     
-    painter.drawText(rect(), Qt::AlignCenter, "GAME OVER");
+    painter.drawText(gameAreaRect(), Qt::AlignCenter, "GAME OVER");
     
     font.setPixelSize(24);
     font.setBold(false);
     painter.setFont(font);
     painter.setPen(Qt::white);
     
-    QRect textRect = rect().adjusted(0, 100, 0, 0);
+    QRect textRect = gameAreaRect().adjusted(0, 100, 0, 0);
     QString scoreText = QString("Score: %1").arg(m_engine->getScore());
     painter.drawText(textRect, Qt::AlignCenter, scoreText);
     
-    textRect = rect().adjusted(0, 150, 0, 0);
+    textRect = gameAreaRect().adjusted(0, 150, 0, 0);
     painter.drawText(textRect, Qt::AlignCenter, "Press R to restart\nPress Q to quit");
     
     painter.restore();
@@ -135,26 +439,24 @@ void GameWidget::renderGameOverScreen(QPainter& painter) {
 void GameWidget::renderLevelCompleteScreen(QPainter& painter) {
     painter.save();
     
-    painter.fillRect(rect(), QColor(0, 0, 0, 180));
-    
     painter.setPen(QColor(50, 255, 50));
     QFont font = painter.font();
     font.setPixelSize(48);
     font.setBold(true);
     painter.setFont(font);
     
-    painter.drawText(rect(), Qt::AlignCenter, "LEVEL COMPLETE!");
+    painter.drawText(gameAreaRect(), Qt::AlignCenter, "LEVEL COMPLETE!");
     
     font.setPixelSize(24);
     font.setBold(false);
     painter.setFont(font);
     painter.setPen(Qt::white);
     
-    QRect textRect = rect().adjusted(0, 100, 0, 0);
+    QRect textRect = gameAreaRect().adjusted(0, 100, 0, 0);
     QString scoreText = QString("Score: %1").arg(m_engine->getScore());
     painter.drawText(textRect, Qt::AlignCenter, scoreText);
     
-    textRect = rect().adjusted(0, 150, 0, 0);
+    textRect = gameAreaRect().adjusted(0, 150, 0, 0);
     painter.drawText(textRect, Qt::AlignCenter, "Press SPACE to continue\nPress Q to quit");
     
     painter.restore();
@@ -167,15 +469,34 @@ void GameWidget::keyPressEvent(QKeyEvent* event) {
     }
     
     switch (event->key()) {
+        case Qt::Key_F2:
+            // Basculer entre QPainter et le rendu logiciel SIMD
+            setSoftwareRendering(!m_softwareRenderer);
+            SaveManager::instance().setSoftwareRendering(m_softwareRenderer != nullptr);
+            break;
+
+        case Qt::Key_F3:
+            // Overlay du profileur (temps par phase des dernières frames)
+            m_showProfiler = !m_showProfiler;
+            update(profilerOverlayRect());
+            break;
+
+        case Qt::Key_F4:
+            // Export au format Chrome trace (chrome://tracing, Perfetto)
+            exportProfilerTrace();
+            break;
+
         case Qt::Key_Space:
             if (m_engine->getState() == GameState::PLAYING) {
                 m_engine->playerShoot();
-            } else if (m_engine->getState() == GameState::LEVEL_COMPLETE) {
-                m_engine->restartGame();
+            } else if (m_engine->getState() == GameState::LEVEL_COMPLETE && !m_engine->isSessionDriven()) {
+                m_engine->nextLevel();
             }
             break;
             
         case Qt::Key_Escape:
+            // Partie réseau : le moteur est partagé avec le pair, ni pause ni relance d'un seul côté
+            if (m_engine->isSessionDriven()) break;
             if (m_engine->getState() == GameState::PLAYING) {
                 m_engine->pauseGame();
             } else if (m_engine->getState() == GameState::PAUSED) {
@@ -184,7 +505,7 @@ void GameWidget::keyPressEvent(QKeyEvent* event) {
             break;
             
         case Qt::Key_R:
-            if (m_engine->getState() == GameState::GAME_OVER) {
+            if (m_engine->getState() == GameState::GAME_OVER && !m_engine->isSessionDriven()) {
                 m_engine->restartGame();
             }
             break;
@@ -199,8 +520,6 @@ void GameWidget::keyPressEvent(QKeyEvent* event) {
             m_engine->processInput(event->key(), true);
             break;
     }
-    
-    update();
 }
 
 void GameWidget::keyReleaseEvent(QKeyEvent* event) {
@@ -210,5 +529,4 @@ void GameWidget::keyReleaseEvent(QKeyEvent* event) {
     }
     
     m_engine->processInput(event->key(), false);
-    update();
 }
@@ -0,0 +1,259 @@
+#include "../include/LevelFile.hpp"
+#include "../include/Constants.hpp"
+#include "../include/WireFormat.hpp"
+#include <QList>
+#include <cstring>
+
+using namespace WireFormat;
+
+namespace {
+// Texte : une ligne par rangée de cases, « wave » pour les vagues, « ; » pour les commentaires
+bool tileForChar(char c, Tile& tile) {
+    switch (c) {
+        case '.': case 'E': case 'P': tile = Tile::EMPTY; return true;
+        case '#': tile = Tile::BRICK; return true;
+        case 'S': tile = Tile::STEEL; return true;
+        case '~': tile = Tile::WATER; return true;
+        case 'T': tile = Tile::TREE; return true;
+        case 'H': tile = Tile::BASE; return true;
+        default: return false;
+    }
+}
+}
+
+LevelFile::~LevelFile() {
+    close();
+}
+
+void LevelFile::close() {
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_header = LevelFileHeader();
+    m_tiles = m_spawns = m_waves = nullptr;
+}
+
+bool LevelFile::fail(const QString& error) {
+    m_error = error;
+    close();
+    return false;
+}
+
+qint64 LevelFile::spawnsOffset(int width, int height) {
+    const qint64 tilesEnd = static_cast<qint64>(sizeof(LevelFileHeader)) + static_cast<qint64>(width) * height;
+    return (tilesEnd + 3) & ~qint64(3);
+}
+
+bool LevelFile::open(const QString& path) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(QString("ouverture impossible: %1").arg(m_file.errorString()));
+    }
+
+    const qint64 size = m_file.size();
+    if (size < static_cast<qint64>(sizeof(LevelFileHeader))) {
+        return fail("fichier tronqué");
+    }
+
+    m_data = m_file.map(0, size);
+    if (!m_data) {
+        return fail("projection en mémoire impossible");
+    }
+
+    const uchar* data = m_data;
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail("signature invalide");
+    }
+
+    std::memcpy(m_header.magic, data, sizeof(MAGIC));
+    m_header.version = readU16(data + 4);
+    m_header.width = readU16(data + 6);
+    m_header.height = readU16(data + 8);
+    m_header.spawnCount = readU16(data + 10);
+    m_header.waveCount = readU16(data + 12);
+    m_header.playerX = readU16(data + 14);
+    m_header.playerY = readU16(data + 16);
+
+    if (m_header.version != VERSION) {
+        return fail(QString("version %1 non prise en charge").arg(m_header.version));
+    }
+    if (m_header.width == 0 || m_header.height == 0 ||
+        m_header.width > GameConstants::GRID_WIDTH || m_header.height > GameConstants::GRID_HEIGHT) {
+        return fail(QString("dimensions invalides: %1x%2").arg(m_header.width).arg(m_header.height));
+    }
+
+    const qint64 spawns = spawnsOffset(m_header.width, m_header.height);
+    const qint64 waves = spawns + static_cast<qint64>(m_header.spawnCount) * SPAWN_ENTRY_SIZE;
+    const qint64 end = waves + static_cast<qint64>(m_header.waveCount) * WAVE_ENTRY_SIZE;
+    if (end > size) {
+        return fail("fichier tronqué");
+    }
+
+    m_tiles = data + sizeof(LevelFileHeader);
+    m_spawns = data + spawns;
+    m_waves = data + waves;
+
+    bool hasBase = false;
+    for (int i = 0; i < m_header.width * m_header.height; i++) {
+        if (m_tiles[i] > static_cast<quint8>(Tile::BASE)) {
+            return fail(QString("case %1 invalide").arg(i));
+        }
+        hasBase |= m_tiles[i] == static_cast<quint8>(Tile::BASE);
+    }
+    for (int i = 0; i < m_header.spawnCount; i++) {
+        const QPoint spawn = spawnAt(i);
+        if (spawn.x() >= m_header.width || spawn.y() >= m_header.height) {
+            return fail("point d'apparition hors carte");
+        }
+    }
+    if (m_header.playerX >= m_header.width || m_header.playerY >= m_header.height) {
+        return fail("départ du joueur hors carte");
+    }
+
+    // Mêmes règles que parseAscii : un fichier forgé ne doit pas bloquer le moteur
+    if (!hasBase) {
+        return fail("base manquante");
+    }
+    if (m_header.spawnCount == 0) {
+        return fail("aucun point d'apparition");
+    }
+    for (int i = 0; i < m_header.waveCount; i++) {
+        const LevelWave wave = waveAt(i);
+        if (wave.maxActive == 0 || wave.spawnIntervalTicks == 0) {
+            return fail(QString("vague %1 invalide").arg(i));
+        }
+    }
+
+    m_error.clear();
+    return true;
+}
+
+QPoint LevelFile::spawnAt(int index) const {
+    const uchar* entry = m_spawns + index * SPAWN_ENTRY_SIZE;
+    return QPoint(readU16(entry), readU16(entry + 2));
+}
+
+LevelWave LevelFile::waveAt(int index) const {
+    const uchar* entry = m_waves + index * WAVE_ENTRY_SIZE;
+    LevelWave wave;
+    wave.enemies = readU16(entry);
+    wave.spawnIntervalTicks = readU16(entry + 2);
+    wave.maxActive = readU16(entry + 4);
+    return wave;
+}
+
+bool LevelFile::parseAscii(const QByteArray& text, LevelLayout& layout, QString* error) {
+    auto reportError = [error](int line, const QString& message) {
+        if (error) *error = QString("ligne %1: %2").arg(line).arg(message);
+        return false;
+    };
+
+    std::vector<QByteArray> rows;
+    std::vector<LevelWave> waves;
+    const QList<QByteArray> lines = text.split('\n');
+
+    for (int i = 0; i < lines.size(); i++) {
+        const QByteArray line = lines[i].trimmed();
+        if (line.isEmpty() || line.startsWith(';')) continue;
+
+        if (line.startsWith("wave")) {
+            // wave <ennemis> <intervalle en ticks> <actifs max>
+            const QList<QByteArray> fields = line.simplified().split(' ');
+            bool ok[3] = {false, false, false};
+            LevelWave wave;
+            if (fields.size() == 4) {
+                wave.enemies = fields[1].toUShort(&ok[0]);
+                wave.spawnIntervalTicks = fields[2].toUShort(&ok[1]);
+                wave.maxActive = fields[3].toUShort(&ok[2]);
+            }
+            if (!ok[0] || !ok[1] || !ok[2] || wave.maxActive == 0 || wave.spawnIntervalTicks == 0) {
+                return reportError(i + 1, "vague attendue: wave <ennemis> <intervalle> <actifs>");
+            }
+            waves.push_back(wave);
+            continue;
+        }
+
+        if (!rows.empty() && line.size() != rows.front().size()) {
+            return reportError(i + 1, "largeur de rangée incohérente");
+        }
+        rows.push_back(line);
+    }
+
+    if (rows.empty()) {
+        return reportError(lines.size(), "aucune rangée de cases");
+    }
+    if (static_cast<int>(rows.front().size()) > GameConstants::GRID_WIDTH ||
+        static_cast<int>(rows.size()) > GameConstants::GRID_HEIGHT) {
+        return reportError(1, QString("carte limitée à %1x%2 cases")
+                                  .arg(GameConstants::GRID_WIDTH).arg(GameConstants::GRID_HEIGHT));
+    }
+
+    layout = LevelLayout(rows.front().size(), static_cast<int>(rows.size()));
+    bool hasBase = false;
+
+    for (int y = 0; y < layout.height; y++) {
+        for (int x = 0; x < layout.width; x++) {
+            const char c = rows[y][x];
+            Tile tile;
+            if (!tileForChar(c, tile)) {
+                return reportError(y + 1, QString("caractère inconnu '%1'").arg(c));
+            }
+            layout.set(x, y, tile);
+            hasBase |= tile == Tile::BASE;
+
+            if (c == 'E') {
+                layout.spawns.push_back(QPoint(x, y));
+            } else if (c == 'P') {
+                layout.playerSpawn = QPoint(x, y);
+            }
+        }
+    }
+
+    if (!hasBase) return reportError(1, "base (H) manquante");
+    if (layout.playerSpawn.x() < 0) return reportError(1, "départ du joueur (P) manquant");
+    if (layout.spawns.empty()) return reportError(1, "aucun point d'apparition (E)");
+
+    // Vague par défaut : le rythme des niveaux générés
+    if (waves.empty()) {
+        waves.push_back(defaultWave());
+    }
+    layout.waves = waves;
+    return true;
+}
+
+QByteArray LevelFile::serialize(const LevelLayout& layout) {
+    QByteArray out;
+    out.reserve(static_cast<int>(spawnsOffset(layout.width, layout.height)
+                                 + layout.spawns.size() * SPAWN_ENTRY_SIZE
+                                 + layout.waves.size() * WAVE_ENTRY_SIZE));
+
+    out.append(MAGIC, sizeof(MAGIC));
+    appendU16(out, VERSION);
+    appendU16(out, static_cast<quint16>(layout.width));
+    appendU16(out, static_cast<quint16>(layout.height));
+    appendU16(out, static_cast<quint16>(layout.spawns.size()));
+    appendU16(out, static_cast<quint16>(layout.waves.size()));
+    appendU16(out, static_cast<quint16>(layout.playerSpawn.x()));
+    appendU16(out, static_cast<quint16>(layout.playerSpawn.y()));
+    out.append(static_cast<int>(sizeof(LevelFileHeader)) - out.size(), '\0');
+
+    for (Tile tile : layout.tiles) {
+        out.append(static_cast<char>(tile));
+    }
+    out.append(static_cast<int>(spawnsOffset(layout.width, layout.height)) - out.size(), '\0');
+
+    for (const QPoint& spawn : layout.spawns) {
+        appendU16(out, static_cast<quint16>(spawn.x()));
+        appendU16(out, static_cast<quint16>(spawn.y()));
+    }
+    for (const LevelWave& wave : layout.waves) {
+        appendU16(out, wave.enemies);
+        appendU16(out, wave.spawnIntervalTicks);
+        appendU16(out, wave.maxActive);
+        appendU16(out, 0);
+    }
+    return out;
+}
@@ -0,0 +1,218 @@
+#include "../include/LevelGenerator.hpp"
+#include <QDebug>
+
+namespace {
+// Remplissage horizontal d'un mot : les bits de départ s'étendent sur les
+// cases ouvertes contiguës, dans les deux sens (remplissage Kogge-Stone)
+quint64 fillWord(quint64 seeds, quint64 open) {
+    quint64 left = seeds & open;
+    quint64 right = left;
+    quint64 leftOpen = open;
+    quint64 rightOpen = open;
+
+    for (int shift = 1; shift < 64; shift <<= 1) {
+        left |= leftOpen & (left << shift);
+        leftOpen &= leftOpen << shift;
+        right |= rightOpen & (right >> shift);
+        rightOpen &= rightOpen >> shift;
+    }
+    return left | right;
+}
+
+// Remplissage d'une ligne de plusieurs mots : chaque mot se remplit seul et
+// une case atteinte en bordure ensemence le mot voisin. Un aller puis un
+// retour suffisent, une plage de cases ouvertes étant contiguë.
+void fillRow(quint64* reach, const quint64* open, int words) {
+    for (int w = 0; w < words; w++) {
+        const quint64 carry = (w > 0 && (reach[w - 1] >> 63)) ? 1 : 0;
+        reach[w] = fillWord(reach[w] | carry, open[w]);
+    }
+    for (int w = words - 2; w >= 0; w--) {
+        if (reach[w + 1] & 1) {
+            reach[w] = fillWord(reach[w] | (quint64(1) << 63), open[w]);
+        }
+    }
+}
+
+// Une ligne gagne les cases ouvertes atteintes sur sa voisine ; vrai si elle a changé
+bool growRow(quint64* row, const quint64* neighbour, const quint64* open, int words) {
+    bool seeded = false;
+    for (int w = 0; w < words; w++) {
+        const quint64 seeds = neighbour[w] & open[w] & ~row[w];
+        if (seeds) {
+            row[w] |= seeds;
+            seeded = true;
+        }
+    }
+    if (seeded) {
+        fillRow(row, open, words);
+    }
+    return seeded;
+}
+
+bool isReached(const std::vector<quint64>& reach, int words, const QPoint& cell) {
+    return (reach[static_cast<size_t>(cell.y()) * words + cell.x() / 64] >> (cell.x() % 64)) & 1;
+}
+}
+
+LevelGenerator::LevelGenerator(quint32 seed)
+    : m_random(seed)
+{
+}
+
+LevelLayout LevelGenerator::generate(const LevelSpec& spec) {
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        LevelLayout layout(spec.width, spec.height);
+        fillCellular(layout, spec);
+
+        if (!isConnected(layout, spec)) {
+            repair(layout, spec);
+        }
+        if (isConnected(layout, spec)) {
+            return layout;
+        }
+        qWarning() << "Niveau non connexe après réparation, tirage" << attempt + 1 << "rejeté";
+    }
+
+    // Départ ou base hors de la carte : aucun tirage ne convient
+    qWarning() << "Aucun niveau connexe en" << MAX_ATTEMPTS << "tirages, terrain vide";
+    return LevelLayout(spec.width, spec.height);
+}
+
+void LevelGenerator::fillCellular(LevelLayout& layout, const LevelSpec& spec) {
+    const int width = spec.width;
+    const int height = spec.height;
+
+    std::vector<quint8> walls(static_cast<size_t>(width) * height);
+    for (quint8& wall : walls) {
+        wall = m_random.bounded(100) < INITIAL_WALL_PERCENT ? 1 : 0;
+    }
+
+    // Lissage « 4-5 » : les cases isolées disparaissent, les amas se forment
+    std::vector<quint8> next(walls.size());
+    for (int step = 0; step < SMOOTHING_STEPS; step++) {
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int neighbours = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        if ((dx || dy) && layout.contains(x + dx, y + dy)) {
+                            neighbours += walls[(y + dy) * width + x + dx];
+                        }
+                    }
+                }
+                const bool wall = walls[y * width + x];
+                next[y * width + x] = (wall && neighbours >= 4) || (!wall && neighbours >= 5);
+            }
+        }
+        walls.swap(next);
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!walls[y * width + x]) continue;
+
+            bool reserved = false;
+            for (const QRect& area : spec.clearAreas) {
+                if (area.contains(x, y)) {
+                    reserved = true;
+                    break;
+                }
+            }
+            if (reserved) continue;
+
+            // Même répartition que l'ancien tirage case par case
+            const int choice = m_random.bounded(100);
+            if (choice < 60) {
+                layout.set(x, y, Tile::BRICK);
+            } else if (choice < 75) {
+                layout.set(x, y, Tile::STEEL);
+            } else if (choice < 85) {
+                layout.set(x, y, Tile::WATER);
+            } else {
+                layout.set(x, y, Tile::TREE);
+            }
+        }
+    }
+}
+
+std::vector<quint64> LevelGenerator::reachableFrom(const LevelLayout& layout, const QPoint& start) {
+    const int height = layout.height;
+    const int words = wordsPerRow(layout.width);
+    auto row = [words](std::vector<quint64>& bits, int y) { return bits.data() + static_cast<size_t>(y) * words; };
+
+    std::vector<quint64> open(static_cast<size_t>(height) * words, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < layout.width; x++) {
+            if (layout.isPassable(x, y)) {
+                row(open, y)[x / 64] |= quint64(1) << (x % 64);
+            }
+        }
+    }
+
+    std::vector<quint64> reach(open.size(), 0);
+    if (!layout.contains(start.x(), start.y())) {
+        return reach;
+    }
+    row(reach, start.y())[start.x() / 64] = quint64(1) << (start.x() % 64);
+    fillRow(row(reach, start.y()), row(open, start.y()), words);
+
+    // Balayages descendant puis montant jusqu'à stabilité
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int y = 1; y < height; y++) {
+            changed |= growRow(row(reach, y), row(reach, y - 1), row(open, y), words);
+        }
+        for (int y = height - 2; y >= 0; y--) {
+            changed |= growRow(row(reach, y), row(reach, y + 1), row(open, y), words);
+        }
+    }
+    return reach;
+}
+
+bool LevelGenerator::isConnected(const LevelLayout& layout, const LevelSpec& spec) {
+    const std::vector<quint64> reach = reachableFrom(layout, spec.target);
+    const int words = wordsPerRow(layout.width);
+    for (const QPoint& source : spec.sources) {
+        if (!layout.contains(source.x(), source.y()) || !isReached(reach, words, source)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LevelGenerator::repair(LevelLayout& layout, const LevelSpec& spec) {
+    // Un couloir en L par point isolé suffit : il ne traverse plus rien d'infranchissable
+    if (!layout.contains(spec.target.x(), spec.target.y())) return;
+
+    const std::vector<quint64> reach = reachableFrom(layout, spec.target);
+    const int words = wordsPerRow(layout.width);
+    int corridors = 0;
+    for (const QPoint& source : spec.sources) {
+        if (layout.contains(source.x(), source.y()) && !isReached(reach, words, source)) {
+            carveCorridor(layout, source, spec.target);
+            corridors++;
+        }
+    }
+
+    qDebug() << "Niveau réparé:" << corridors << "couloir(s) creusé(s)";
+}
+
+void LevelGenerator::carveCorridor(LevelLayout& layout, const QPoint& from, const QPoint& to) {
+    auto clear = [&layout](int x, int y) {
+        if (!layout.isPassable(x, y)) {
+            layout.set(x, y, Tile::EMPTY);
+        }
+    };
+
+    // Verticalement d'abord, puis horizontalement sur la ligne de la base
+    const int stepY = to.y() >= from.y() ? 1 : -1;
+    for (int y = from.y(); y != to.y(); y += stepY) {
+        clear(from.x(), y);
+    }
+    const int stepX = to.x() >= from.x() ? 1 : -1;
+    for (int x = from.x(); x != to.x() + stepX; x += stepX) {
+        clear(x, to.y());
+    }
+}
@@ -0,0 +1,561 @@
+#include "../include/LockstepSession.hpp"
+#include "../include/BotPlayer.hpp"
+#include "../include/ReplayFile.hpp"
+#include "../include/WireFormat.hpp"
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QNetworkDatagram>
+#include <QTextStream>
+#include <QDebug>
+
+using namespace WireFormat;
+
+namespace {
+// Paquets : un octet de type, puis des champs en petit-boutiste
+enum PacketType : quint8 {
+    PACKET_HELLO,       // Client -> hôte, jusqu'au départ
+    PACKET_START,       // Hôte -> client : graine (u32)
+    PACKET_INPUT,       // ack (u32), premier tick (u32), nombre (u8), masques
+    PACKET_INPUT_HASH   // PACKET_INPUT suivi du tick (u32) et de l'empreinte (u64)
+};
+
+constexpr int INPUT_HEADER_SIZE = 1 + 4 + 4 + 1;
+constexpr int HASH_SIZE = 4 + 8;
+constexpr int HASH_EVERY_PACKETS = 4;       // Empreinte jointe à un paquet sur quatre
+}
+
+LockstepSession::LockstepSession(GameEngine* engine, const LockstepConfig& config, QObject* parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_config(config)
+    , m_socket(new QUdpSocket(this))
+    , m_helloTimer(new QTimer(this))
+    , m_scheduler(engine->detachScheduler())
+    , m_running(false)
+    , m_finished(false)
+    , m_localPlayer(0)
+    , m_seed(0)
+    , m_tick(0)
+    , m_remoteKnown(0)
+    , m_localKnown(0)
+    , m_peerAck(0)
+    , m_rollbackTick(NO_ROLLBACK)
+    , m_heldInput(0)
+    , m_confirmed(0)
+    , m_endTick(0)
+    , m_recorder(nullptr)
+    , m_remoteHashTick(0)
+    , m_remoteHash(0)
+    , m_remoteHashPending(false)
+    , m_lastHashChecked(-1)
+    , m_lossRandom(config.seed ^ 0x5A5A5A5Au)
+{
+    m_config.inputDelay = qBound(0, m_config.inputDelay, MAX_ROLLBACK);
+
+    // Le tick du FrameScheduler passe par la session, qui décide quand
+    // le moteur peut avancer et avec quelles entrées. Il continue après
+    // la fin de partie : les renvois d'entrées doivent atteindre le pair.
+    connect(m_scheduler, &FrameScheduler::tick, this, &LockstepSession::advance);
+
+    connect(m_socket, &QUdpSocket::readyRead, this, &LockstepSession::onReadyRead);
+    connect(m_helloTimer, &QTimer::timeout, this, &LockstepSession::sendHello);
+
+    m_clock.start();
+}
+
+bool LockstepSession::start() {
+    if (!m_socket->bind(QHostAddress::Any, m_config.localPort)) {
+        m_error = m_socket->errorString();
+        return false;
+    }
+
+    const bool host = m_config.peerAddress.isNull();
+    m_localPlayer = host ? 0 : 1;
+    if (!host) {
+        sendHello();
+        m_helloTimer->start(HELLO_INTERVAL_MS);
+    }
+
+    qDebug() << "Lockstep:" << (host ? "hôte" : "client") << "sur le port" << m_socket->localPort();
+    return true;
+}
+
+quint64 LockstepSession::confirmedHash() const {
+    const quint32 confirmed = m_finished ? m_endTick : finalTick();
+    if (confirmed == 0) return 0;
+    return m_records[(confirmed - 1) % HISTORY].hash;
+}
+
+void LockstepSession::setRecorder(ReplayWriter* writer) {
+    m_recorder = writer;
+    m_recordStates.resize(writer ? HISTORY : 0);
+}
+
+void LockstepSession::sendHello() {
+    flushOutgoing();
+    if (m_running) {
+        m_helloTimer->stop();
+        return;
+    }
+    sendDatagram(QByteArray(1, static_cast<char>(PACKET_HELLO)));
+}
+
+void LockstepSession::begin(quint32 seed) {
+    m_seed = seed;
+    m_running = true;
+    m_finished = false;
+    m_helloTimer->stop();
+
+    // Les inputDelay premiers ticks n'ont d'entrée d'aucun côté
+    m_records.fill(TickRecord());
+    for (quint32 tick = 0; tick < static_cast<quint32>(m_config.inputDelay); tick++) {
+        TickRecord& entry = record(tick);
+        entry.remoteReceived = true;
+    }
+    m_tick = 0;
+    m_remoteKnown = m_config.inputDelay;
+    m_localKnown = m_config.inputDelay;
+    m_peerAck = m_config.inputDelay;
+    m_rollbackTick = NO_ROLLBACK;
+    m_heldInput = 0;
+    m_confirmed = 0;
+    m_endTick = 0;
+    m_remoteHashPending = false;
+    m_lastHashChecked = -1;
+    m_stats = LockstepStats();
+
+    m_engine->setSeed(seed);
+    m_engine->setPlayerCount(2);
+    m_engine->startGame();
+
+    qDebug() << "Lockstep: partie lancée, graine" << seed << "- joueur" << m_localPlayer;
+    emit started(seed);
+}
+
+void LockstepSession::advance() {
+    if (!m_running) return;
+    flushOutgoing();
+
+    // Partie finie : on continue d'envoyer pour que le pair termine aussi
+    if (m_finished) {
+        sendInputs();
+        return;
+    }
+
+    if (m_rollbackTick != NO_ROLLBACK) {
+        rollback();
+    }
+
+    processConfirmedTicks();
+    if (m_finished) {
+        sendInputs();
+        return;
+    }
+
+    if (m_config.tickLimit > 0 && m_tick >= static_cast<quint32>(m_config.tickLimit)) {
+        sendInputs();
+        checkRemoteHash();
+        if (m_remoteKnown >= m_tick) {
+            finish(m_tick);
+        }
+        return;
+    }
+
+    // Trop d'avance sur le pair : on attend plutôt que de prédire plus loin
+    if (static_cast<qint64>(m_tick) - m_remoteKnown >= MAX_ROLLBACK) {
+        m_stats.stalls++;
+        sendInputs();
+        return;
+    }
+
+    sampleLocalInput(m_tick + m_config.inputDelay);
+    sendInputs();
+    simulateTick(m_tick);
+    m_tick++;
+    checkRemoteHash();
+}
+
+void LockstepSession::processConfirmedTicks() {
+    // Une fin de partie ne compte que sur un tick confirmé : un tick
+    // prédit peut encore être rejoué avec les vraies entrées du pair
+    const quint32 confirmed = finalTick();
+    while (m_confirmed < confirmed && !m_finished) {
+        const TickRecord& entry = m_records[m_confirmed % HISTORY];
+        if (m_recorder && !m_recorder->append(m_recordStates[m_confirmed % HISTORY])) {
+            qWarning() << "Replay interrompu:" << m_recorder->errorString();
+            m_recorder = nullptr;
+        }
+        m_confirmed++;
+        if (entry.ended) {
+            finish(m_confirmed);
+            // Le moteur n'annonce pas lui-même une fin peut-être seulement prédite
+            emit m_engine->gameStateChanged(m_engine->getState());
+        }
+    }
+}
+
+void LockstepSession::finish(quint32 endTick) {
+    m_finished = true;
+    m_endTick = endTick;
+    qDebug() << "Lockstep: fin au tick" << m_endTick << "- retours arrière" << m_stats.rollbacks
+             << "- désynchronisations" << m_stats.desyncs;
+    emit finished();
+}
+
+void LockstepSession::sampleLocalInput(quint32 tick) {
+    // Clavier ou bot : tout ce qui est arrivé depuis le tick précédent
+    m_engine->takeInput(m_drained);
+
+    quint8 pressed = 0;
+    for (const InputEvent& event : m_drained) {
+        const quint8 bit = actionBit(event.action);
+        if (event.pressed) {
+            pressed |= bit;
+            if (bit != SHOOT_BIT) m_heldInput |= bit;
+        } else {
+            m_heldInput &= ~bit;
+        }
+    }
+
+    // Un appui relâché dans le même tick compte pour ce tick
+    record(tick).local = m_heldInput | pressed;
+    m_localKnown = tick + 1;
+}
+
+void LockstepSession::simulateTick(quint32 tick) {
+    m_engine->saveSnapshot(m_snapshots[tick % (MAX_ROLLBACK + 1)]);
+
+    TickRecord& current = record(tick);
+    current.usedRemote = current.remoteReceived ? current.remote : predictRemote();
+
+    quint8 masks[2];
+    quint8 previous[2] = {0, 0};
+    masks[m_localPlayer] = current.local;
+    masks[1 - m_localPlayer] = current.usedRemote;
+    if (tick > 0) {
+        const TickRecord& before = m_records[(tick - 1) % HISTORY];
+        previous[m_localPlayer] = before.local;
+        previous[1 - m_localPlayer] = before.usedRemote;
+    }
+
+    // Mêmes événements, dans le même ordre, sur les deux machines
+    for (quint8 player = 0; player < 2; player++) {
+        const quint8 changed = (masks[player] ^ previous[player]) & MOVE_BITS;
+        for (int bit = 0; bit < 4; bit++) {
+            if (changed & (1 << bit)) {
+                m_engine->submitInput(InputEvent{static_cast<InputAction>(bit),
+                                                 (masks[player] & (1 << bit)) != 0, player});
+            }
+        }
+        if (masks[player] & SHOOT_BIT) {
+            m_engine->submitInput(InputEvent{InputAction::SHOOT, true, player});
+        }
+    }
+
+    m_engine->stepTick();
+    current.ended = m_engine->getState() != GameState::PLAYING;
+    current.hash = m_engine->stateHash();
+    if (m_recorder) {
+        m_recordStates[tick % HISTORY].capture(*m_engine);
+    }
+}
+
+void LockstepSession::rollback() {
+    const quint32 target = m_rollbackTick;
+    m_rollbackTick = NO_ROLLBACK;
+
+    // Clavier ou bot arrivés depuis le dernier tick : mis de côté pour le
+    // prochain relevé, les ticks rejoués ne voient que les entrées de la session
+    m_engine->takeInput(m_deferredInput);
+
+    m_engine->restoreSnapshot(m_snapshots[target % (MAX_ROLLBACK + 1)]);
+
+    // Ticks rejoués sans sons ni signaux : ils ont déjà été présentés
+    m_engine->setResimulating(true);
+    for (quint32 tick = target; tick < m_tick; tick++) {
+        simulateTick(tick);
+    }
+    m_engine->setResimulating(false);
+
+    for (const InputEvent& event : m_deferredInput) {
+        m_engine->submitInput(event);
+    }
+
+    const int depth = static_cast<int>(m_tick - target);
+    m_stats.rollbacks++;
+    m_stats.rolledBackTicks += depth;
+    m_stats.maxRollback = qMax(m_stats.maxRollback, depth);
+}
+
+void LockstepSession::sendInputs() {
+    // Toutes les entrées locales que le pair n'a pas confirmées
+    const quint32 oldest = m_localKnown > MAX_INPUTS_PER_PACKET ? m_localKnown - MAX_INPUTS_PER_PACKET : 0;
+    const quint32 first = qMax(m_peerAck, oldest);
+    const quint32 count = m_localKnown - first;
+
+    const quint32 confirmed = finalTick();
+    const quint32 checkpoint = confirmed - confirmed % HASH_INTERVAL;   // Ticks [0, checkpoint) définitifs
+    const bool withHash = checkpoint > 0 && m_stats.packetsSent % HASH_EVERY_PACKETS == 0;
+
+    QByteArray packet;
+    packet.reserve(INPUT_HEADER_SIZE + count + HASH_SIZE);
+    packet.append(static_cast<char>(withHash ? PACKET_INPUT_HASH : PACKET_INPUT));
+    appendU32(packet, m_remoteKnown);
+    appendU32(packet, first);
+    packet.append(static_cast<char>(count));
+    for (quint32 tick = first; tick < m_localKnown; tick++) {
+        packet.append(static_cast<char>(m_records[tick % HISTORY].local));
+    }
+    if (withHash) {
+        appendU32(packet, checkpoint - 1);
+        appendU64(packet, m_records[(checkpoint - 1) % HISTORY].hash);
+    }
+    sendDatagram(packet);
+}
+
+void LockstepSession::checkRemoteHash() {
+    if (!m_remoteHashPending || m_remoteHashTick >= finalTick()) return;
+    m_remoteHashPending = false;
+
+    const TickRecord& entry = m_records[m_remoteHashTick % HISTORY];
+    if (entry.tick != m_remoteHashTick) return;   // Trop ancien
+
+    m_lastHashChecked = m_remoteHashTick;
+    m_stats.hashesChecked++;
+    if (entry.hash != m_remoteHash) {
+        m_stats.desyncs++;
+        qWarning() << "Lockstep: désynchronisation au tick" << m_remoteHashTick
+                   << "- local" << Qt::hex << entry.hash << "distant" << m_remoteHash;
+        emit desyncDetected(m_remoteHashTick);
+    }
+}
+
+void LockstepSession::sendDatagram(const QByteArray& data) {
+    if (m_config.peerPort == 0) return;   // Hôte sans pair
+
+    m_stats.packetsSent++;
+    m_stats.bytesSent += data.size();
+    if (m_config.lossPercent > 0 && static_cast<int>(m_lossRandom.bounded(100)) < m_config.lossPercent) {
+        m_stats.packetsDropped++;
+        return;
+    }
+
+    if (m_config.latencyMs > 0) {
+        m_outgoing.push_back(PendingPacket{m_clock.nsecsElapsed() + m_config.latencyMs * 1000000LL, data});
+        return;
+    }
+    m_socket->writeDatagram(data, m_config.peerAddress, m_config.peerPort);
+}
+
+void LockstepSession::flushOutgoing() {
+    const qint64 now = m_clock.nsecsElapsed();
+    while (!m_outgoing.empty() && m_outgoing.front().dueNs <= now) {
+        m_socket->writeDatagram(m_outgoing.front().data, m_config.peerAddress, m_config.peerPort);
+        m_outgoing.pop_front();
+    }
+}
+
+LockstepSession::TickRecord& LockstepSession::record(quint32 tick) {
+    TickRecord& entry = m_records[tick % HISTORY];
+    if (entry.tick != tick) {
+        entry = TickRecord();
+        entry.tick = tick;
+    }
+    return entry;
+}
+
+bool LockstepSession::hasRemote(quint32 tick) const {
+    const TickRecord& entry = m_records[tick % HISTORY];
+    return entry.tick == tick && entry.remoteReceived;
+}
+
+quint8 LockstepSession::predictRemote() const {
+    // Le pair garde probablement les mêmes directions ; un tir ne se répète pas
+    if (m_remoteKnown == 0) return 0;
+    return m_records[(m_remoteKnown - 1) % HISTORY].remote & MOVE_BITS;
+}
+
+quint32 LockstepSession::finalTick() const {
+    quint32 confirmed = qMin(m_remoteKnown, m_tick);
+    if (m_rollbackTick != NO_ROLLBACK) {
+        confirmed = qMin(confirmed, m_rollbackTick);
+    }
+    return confirmed;
+}
+
+void LockstepSession::onReadyRead() {
+    while (m_socket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = m_socket->receiveDatagram();
+        const QByteArray data = datagram.data();
+        if (data.isEmpty()) continue;
+
+        // L'hôte adopte le premier client qui se présente
+        if (m_config.peerPort == 0 && static_cast<quint8>(data[0]) == PACKET_HELLO) {
+            m_config.peerAddress = datagram.senderAddress();
+            m_config.peerPort = static_cast<quint16>(datagram.senderPort());
+            qDebug() << "Lockstep: pair" << m_config.peerAddress.toString() << m_config.peerPort;
+        }
+        if (datagram.senderPort() != m_config.peerPort) continue;
+
+        m_stats.packetsReceived++;
+        handlePacket(data);
+    }
+    checkRemoteHash();
+}
+
+void LockstepSession::handlePacket(const QByteArray& data) {
+    const char* bytes = data.constData();
+    const quint8 type = static_cast<quint8>(bytes[0]);
+
+    if (type == PACKET_HELLO) {
+        if (m_localPlayer != 0) return;
+        if (!m_running) {
+            begin(m_config.seed != 0 ? m_config.seed : QRandomGenerator::global()->generate());
+        }
+        // Renvoyé à chaque HELLO : le START précédent a pu se perdre
+        QByteArray start(1, static_cast<char>(PACKET_START));
+        appendU32(start, m_seed);
+        sendDatagram(start);
+        return;
+    }
+
+    if (type == PACKET_START) {
+        if (m_localPlayer == 1 && !m_running && data.size() >= 5) {
+            begin(readU32(bytes + 1));
+        }
+        return;
+    }
+
+    if ((type != PACKET_INPUT && type != PACKET_INPUT_HASH) || !m_running || data.size() < INPUT_HEADER_SIZE) return;
+
+    const quint32 ack = readU32(bytes + 1);
+    const quint32 first = readU32(bytes + 5);
+    const int count = static_cast<quint8>(bytes[9]);
+    if (data.size() < INPUT_HEADER_SIZE + count + (type == PACKET_INPUT_HASH ? HASH_SIZE : 0)) return;
+
+    if (ack <= m_localKnown) {
+        m_peerAck = qMax(m_peerAck, ack);
+    }
+
+    for (int i = 0; i < count; i++) {
+        const quint32 tick = first + i;
+        if (tick < m_remoteKnown) continue;             // Déjà confirmé
+        if (tick >= m_tick + HISTORY / 2) break;        // Hors de l'historique
+
+        const quint8 mask = static_cast<quint8>(bytes[INPUT_HEADER_SIZE + i]);
+        TickRecord& entry = record(tick);
+        if (entry.remoteReceived) continue;
+        entry.remote = mask;
+        entry.remoteReceived = true;
+
+        // Tick déjà simulé avec une autre entrée : retour arrière au prochain advance()
+        if (tick < m_tick && entry.usedRemote != mask) {
+            m_rollbackTick = qMin(m_rollbackTick, tick);
+        }
+    }
+    while (hasRemote(m_remoteKnown)) {
+        m_remoteKnown++;
+    }
+
+    if (type == PACKET_INPUT_HASH) {
+        const char* hash = bytes + INPUT_HEADER_SIZE + count;
+        const quint32 hashTick = readU32(hash);
+        if (static_cast<qint64>(hashTick) > m_lastHashChecked) {
+            m_remoteHashTick = hashTick;
+            m_remoteHash = readU64(hash + 4);
+            m_remoteHashPending = true;
+        }
+    }
+}
+
+void LockstepSession::addCommandLineOptions(QCommandLineParser& parser) {
+    parser.addOption(QCommandLineOption("host", "Héberger une partie réseau sur ce port UDP.", "port"));
+    parser.addOption(QCommandLineOption("connect", "Rejoindre une partie réseau.", "adresse:port"));
+    parser.addOption(QCommandLineOption("port", "Port UDP local du client (0 = automatique).", "port", "0"));
+    parser.addOption(QCommandLineOption("input-delay", "Retard des entrées locales, en ticks.", "n",
+                                        QString::number(LockstepConfig().inputDelay)));
+    parser.addOption(QCommandLineOption("net-latency", "Latence simulée à l'envoi, en ms.", "ms", "0"));
+    parser.addOption(QCommandLineOption("net-loss", "Pourcentage de paquets perdus à l'envoi.", "pourcent", "0"));
+}
+
+bool LockstepSession::configFromCommandLine(const QCommandLineParser& parser, LockstepConfig& config) {
+    if (parser.isSet("host")) {
+        config.localPort = static_cast<quint16>(parser.value("host").toUInt());
+    } else if (parser.isSet("connect")) {
+        const QString target = parser.value("connect");
+        const int colon = target.lastIndexOf(':');
+        if (colon <= 0) return false;
+        config.peerAddress = QHostAddress(target.left(colon));
+        config.peerPort = static_cast<quint16>(target.mid(colon + 1).toUInt());
+        config.localPort = static_cast<quint16>(parser.value("port").toUInt());
+        if (config.peerAddress.isNull() || config.peerPort == 0) return false;
+    } else {
+        return false;
+    }
+
+    config.inputDelay = qBound(0, parser.value("input-delay").toInt(), MAX_ROLLBACK);
+    config.latencyMs = qMax(0, parser.value("net-latency").toInt());
+    config.lossPercent = qBound(0, parser.value("net-loss").toInt(), 100);
+    return true;
+}
+
+int LockstepSession::runFromCommandLine(const QCoreApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Partie réseau en lockstep entre deux bots");
+    parser.addHelpOption();
+    addCommandLineOptions(parser);
+
+    const QCommandLineOption botOption("net-bot", "Deux processus sans interface pilotés par BotPlayer.");
+    const QCommandLineOption seedOption("seed", "Graine de la partie (hôte, 0 = hasard).", "graine", "1");
+    const QCommandLineOption ticksOption("net-ticks", "Ticks à simuler avant de comparer les empreintes.", "n",
+                                         QString::number(60 * GameConstants::SIMULATION_RATE));
+    for (const auto& option : {botOption, seedOption, ticksOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    LockstepConfig config;
+    if (!configFromCommandLine(parser, config)) {
+        qWarning() << "--net-bot demande --host <port> ou --connect <adresse:port>";
+        return 1;
+    }
+    config.seed = parser.value(seedOption).toUInt();
+    config.tickLimit = qMax(1, parser.value(ticksOption).toInt());
+
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    GameEngine engine;
+    engine.setPreloadNextLevel(false);   // La session s'arrête à la fin du niveau
+    LockstepSession session(&engine, config);
+    if (!session.start()) {
+        qWarning() << "Socket UDP indisponible:" << session.errorString();
+        return 1;
+    }
+
+    // Le bot joue le tank local ; ses entrées sont relevées au tick suivant
+    BotPlayer bot(config.seed + 1 + session.localPlayer(), static_cast<quint8>(session.localPlayer()));
+    connect(session.m_scheduler, &FrameScheduler::tick, &session, [&]() {
+        if (session.m_running && !session.m_finished && engine.getState() == GameState::PLAYING) {
+            bot.think(engine);
+        }
+    });
+
+    connect(&session, &LockstepSession::finished, &session, [&]() {
+        const LockstepStats& stats = session.getStats();
+        const quint32 ticks = session.endTick();
+        QTextStream out(stdout);
+        out << "lockstep_result player=" << session.localPlayer() << " seed=" << session.m_seed
+            << " ticks=" << ticks << " confirmed_hash=" << Qt::hex << session.confirmedHash() << Qt::dec
+            << " rollbacks=" << stats.rollbacks << " rolled_back_ticks=" << stats.rolledBackTicks
+            << " max_rollback=" << stats.maxRollback << " stalls=" << stats.stalls
+            << " hashes_checked=" << stats.hashesChecked << " desyncs=" << stats.desyncs
+            << " packets_sent=" << stats.packetsSent << " packets_dropped=" << stats.packetsDropped
+            << " bytes_per_tick=" << (ticks > 0 ? static_cast<double>(stats.bytesSent) / ticks : 0.0) << "\n";
+        out.flush();
+
+        // Laisser au pair le temps de recevoir nos dernières entrées
+        QTimer::singleShot(FINISH_LINGER_MS, QCoreApplication::instance(), &QCoreApplication::quit);
+    });
+
+    return QCoreApplication::exec();
+}
@@ -15,6 +15,10 @@ MainWindow::MainWindow(QWidget *parent)
     // --- Moteur du jeu ---
     m_gameEngine = new GameEngine(this);
 
+    // --- Sons : mixeur démarré avant la première frame ---
+    m_sound = new SoundManager(this);
+    m_sound->initialize();
+
     // --- Widget de jeu ---
     m_gameScene = new GameWidget(m_gameEngine, this);
 
@@ -36,11 +40,59 @@ MainWindow::MainWindow(QWidget *parent)
             m_stack->setCurrentWidget(m_menu);
         }
     });
+    connect(m_gameEngine, &GameEngine::gameEvents, m_sound, &SoundManager::onGameEvents);
 
     // Démarrer l’update du moteur
     m_gameEngine->startGame();
 }
 
+void MainWindow::setCampaign(const QStringList& levelFiles)
+{
+    m_gameEngine->setCampaign(levelFiles);
+    m_gameEngine->restartGame();
+}
+
+bool MainWindow::startNetworkGame(const LockstepConfig& config)
+{
+    // Un niveau préparé en fond depuis un tick prédit ou rejoué ne servirait pas
+    m_gameEngine->setPreloadNextLevel(false);
+    m_session = new LockstepSession(m_gameEngine, config, this);
+    connect(m_session, &LockstepSession::started, this, [this](quint32 seed){
+        m_stack->setCurrentWidget(m_gameScene);
+        m_gameScene->setFocus();
+        qDebug() << "Partie réseau démarrée, graine" << seed;
+    });
+    if (!m_session->start()) {
+        qWarning() << "Partie réseau impossible:" << m_session->errorString();
+        return false;
+    }
+    return true;
+}
+
+bool MainWindow::startRecording(const QString& path)
+{
+    m_replay = std::make_unique<ReplayWriter>();
+    QString error;
+    if (!m_replay->open(path, 0, &error)) {
+        qWarning() << "Replay impossible:" << path << "-" << error;
+        m_replay.reset();
+        return false;
+    }
+    // Partie réseau : la session n'écrit que les ticks confirmés
+    if (m_session) {
+        m_session->setRecorder(m_replay.get());
+        return true;
+    }
+    // Toutes les parties de la session, à la suite, un enregistrement par tick
+    connect(m_gameEngine, &GameEngine::tickCompleted, this, [this](){
+        if (m_replay && !m_replay->recordTick(*m_gameEngine)) {
+            qWarning() << "Replay interrompu:" << m_replay->errorString();
+            m_replay.reset();
+        }
+    });
+    return true;
+}
+
 void MainWindow::onStartGame()
 {
     m_stack->setCurrentWidget(m_gameScene);
@@ -0,0 +1,289 @@
+#include "../include/PixelKernels.hpp"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TANK_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 compilé à part et choisi à l'exécution (GCC / Clang sur x86)
+#if defined(TANK_HAVE_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TANK_HAVE_AVX2 1
+#define TANK_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace PixelKernels {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Scalaire
+// ---------------------------------------------------------------------------
+
+// Multiplier les 4 canaux de x par a / 255
+inline quint32 byteMul(quint32 x, quint32 a) {
+    quint32 t = (x & 0xff00ff) * a;
+    t = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+    t &= 0xff00ff;
+
+    x = ((x >> 8) & 0xff00ff) * a;
+    x = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+    x &= 0xff00ff00;
+    return x | t;
+}
+
+inline void blendPixel(quint32& dst, quint32 src) {
+    const quint32 alpha = src >> 24;
+    if (alpha == 255) {
+        dst = src;
+    } else if (alpha != 0) {
+        dst = src + byteMul(dst, 255 - alpha);
+    }
+}
+
+void fillScalar(quint32* dst, int count, quint32 color) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+void copyScalar(quint32* dst, const quint32* src, int count) {
+    std::memcpy(dst, src, static_cast<size_t>(count) * sizeof(quint32));
+}
+
+void blendScalar(quint32* dst, const quint32* src, int count) {
+    for (int i = 0; i < count; i++) {
+        blendPixel(dst[i], src[i]);
+    }
+}
+
+void blendSolidScalar(quint32* dst, int count, quint32 color) {
+    const quint32 inverseAlpha = 255 - (color >> 24);
+    for (int i = 0; i < count; i++) {
+        dst[i] = color + byteMul(dst[i], inverseAlpha);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SSE2 : 4 pixels par itération
+// ---------------------------------------------------------------------------
+#ifdef TANK_HAVE_SSE2
+
+// x / 255 arrondi, pour x dans [0, 255 * 255]
+inline __m128i div255Sse2(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Diffuser l'alpha de chaque pixel sur ses 4 canaux 16 bits
+inline __m128i broadcastAlphaSse2(__m128i pixels16) {
+    pixels16 = _mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+void fillSse2(quint32* dst, int count, quint32 color) {
+    const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+    }
+    fillScalar(dst + i, count - i, color);
+}
+
+void copySse2(quint32* dst, const quint32* src, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    }
+    copyScalar(dst + i, src + i, count - i);
+}
+
+void blendSse2(quint32* dst, const quint32* src, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+    const __m128i max = _mm_set1_epi16(255);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i alpha = _mm_and_si128(s, alphaMask);
+
+        // Cas fréquents des sprites : 4 pixels opaques ou 4 transparents
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xffff) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xffff) {
+            continue;
+        }
+
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i inverseLo = _mm_sub_epi16(max, broadcastAlphaSse2(_mm_unpacklo_epi8(s, zero)));
+        const __m128i inverseHi = _mm_sub_epi16(max, broadcastAlphaSse2(_mm_unpackhi_epi8(s, zero)));
+
+        const __m128i dLo = div255Sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverseLo));
+        const __m128i dHi = div255Sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverseHi));
+
+        const __m128i result = _mm_add_epi8(_mm_packus_epi16(dLo, dHi), s);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+    }
+    blendScalar(dst + i, src + i, count - i);
+}
+
+void blendSolidSse2(quint32* dst, int count, quint32 color) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i source = _mm_set1_epi32(static_cast<int>(color));
+    const __m128i inverseAlpha = _mm_set1_epi16(static_cast<short>(255 - (color >> 24)));
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i dLo = div255Sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverseAlpha));
+        const __m128i dHi = div255Sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverseAlpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_add_epi8(_mm_packus_epi16(dLo, dHi), source));
+    }
+    blendSolidScalar(dst + i, count - i, color);
+}
+
+#endif // TANK_HAVE_SSE2
+
+// ---------------------------------------------------------------------------
+// AVX2 : 8 pixels par itération
+// ---------------------------------------------------------------------------
+#ifdef TANK_HAVE_AVX2
+
+TANK_TARGET_AVX2 inline __m256i div255Avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+TANK_TARGET_AVX2 inline __m256i broadcastAlphaAvx2(__m256i pixels16) {
+    pixels16 = _mm256_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_shufflehi_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+TANK_TARGET_AVX2 void fillAvx2(quint32* dst, int count, quint32 color) {
+    const __m256i value = _mm256_set1_epi32(static_cast<int>(color));
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), value);
+    }
+    fillSse2(dst + i, count - i, color);
+}
+
+TANK_TARGET_AVX2 void copyAvx2(quint32* dst, const quint32* src, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+    }
+    copySse2(dst + i, src + i, count - i);
+}
+
+TANK_TARGET_AVX2 void blendAvx2(quint32* dst, const quint32* src, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xff000000));
+    const __m256i max = _mm256_set1_epi16(255);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i alpha = _mm256_and_si256(s, alphaMask);
+
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alphaMask)) == -1) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+            continue;
+        }
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, zero)) == -1) {
+            continue;
+        }
+
+        // unpack / pack travaillent par voie de 128 bits : l'ordre est conservé
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i inverseLo = _mm256_sub_epi16(max, broadcastAlphaAvx2(_mm256_unpacklo_epi8(s, zero)));
+        const __m256i inverseHi = _mm256_sub_epi16(max, broadcastAlphaAvx2(_mm256_unpackhi_epi8(s, zero)));
+
+        const __m256i dLo = div255Avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inverseLo));
+        const __m256i dHi = div255Avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inverseHi));
+
+        const __m256i result = _mm256_add_epi8(_mm256_packus_epi16(dLo, dHi), s);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+    }
+    blendSse2(dst + i, src + i, count - i);
+}
+
+TANK_TARGET_AVX2 void blendSolidAvx2(quint32* dst, int count, quint32 color) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i source = _mm256_set1_epi32(static_cast<int>(color));
+    const __m256i inverseAlpha = _mm256_set1_epi16(static_cast<short>(255 - (color >> 24)));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i dLo = div255Avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inverseAlpha));
+        const __m256i dHi = div255Avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inverseAlpha));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_add_epi8(_mm256_packus_epi16(dLo, dHi), source));
+    }
+    blendSolidSse2(dst + i, count - i, color);
+}
+
+#endif // TANK_HAVE_AVX2
+
+// ---------------------------------------------------------------------------
+// Sélection à l'exécution
+// ---------------------------------------------------------------------------
+
+struct KernelTable {
+    void (*fill)(quint32*, int, quint32);
+    void (*copy)(quint32*, const quint32*, int);
+    void (*blend)(quint32*, const quint32*, int);
+    void (*blendSolid)(quint32*, int, quint32);
+    const char* name;
+};
+
+KernelTable selectKernels() {
+#ifdef TANK_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return { fillAvx2, copyAvx2, blendAvx2, blendSolidAvx2, "avx2" };
+    }
+#endif
+#ifdef TANK_HAVE_SSE2
+    return { fillSse2, copySse2, blendSse2, blendSolidSse2, "sse2" };
+#else
+    return { fillScalar, copyScalar, blendScalar, blendSolidScalar, "scalar" };
+#endif
+}
+
+const KernelTable& kernels() {
+    static const KernelTable table = selectKernels();
+    return table;
+}
+
+} // namespace
+
+void fillSpan(quint32* dst, int count, quint32 color) {
+    kernels().fill(dst, count, color);
+}
+
+void copySpan(quint32* dst, const quint32* src, int count) {
+    kernels().copy(dst, src, count);
+}
+
+void blendSpan(quint32* dst, const quint32* src, int count) {
+    kernels().blend(dst, src, count);
+}
+
+void blendSolidSpan(quint32* dst, int count, quint32 color) {
+    kernels().blendSolid(dst, count, color);
+}
+
+const char* activeImplementation() {
+    return kernels().name;
+}
+
+} // namespace PixelKernels
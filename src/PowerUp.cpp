@@ -2,8 +2,8 @@
 #include "../include/Constants.hpp"
 #include <QPainter>
 
-PowerUp::PowerUp(const QPointF& position, PowerUpType powerUpType)
-    : Entity(QRectF(position, QSizeF(POWERUP_SIZE, POWERUP_SIZE)),
+PowerUp::PowerUp(const FixedPoint& position, PowerUpType powerUpType)
+    : Entity(FixedRect::square(position, POWERUP_SIZE),
              powerUpTypeToEntityType(powerUpType),
              powerUpTypeToColor(powerUpType))
     , m_powerUpType(powerUpType)
@@ -49,21 +49,22 @@ void PowerUp::render(QPainter& painter) {
     if (!m_active) return;
 
     // Blink when about to expire
-    if (m_lifetime < 60 && (m_blinkTimer / 10) % 2 == 0) {
+    if (isBlinkHidden()) {
         return;
     }
 
+    const QRectF rect = getRect();
     painter.save();
     painter.setBrush(m_color);
     painter.setPen(QPen(m_color.darker(150), 2));
 
-    const qreal centerX = m_rect.center().x();
-    const qreal centerY = m_rect.center().y();
+    const qreal centerX = rect.center().x();
+    const qreal centerY = rect.center().y();
 
     switch (m_powerUpType) {
     case PowerUpType::HEALTH: {
         // Draw health cross
-        painter.drawRect(m_rect);
+        painter.drawRect(rect);
         painter.setBrush(Qt::white);
         QRectF hRect(centerX - 8, centerY - 2, 16, 4);
         QRectF vRect(centerX - 2, centerY - 8, 4, 16);
@@ -74,19 +75,19 @@ void PowerUp::render(QPainter& painter) {
 
     case PowerUpType::BOMB: {
         // Draw bomb
-        painter.drawEllipse(m_rect);
+        painter.drawEllipse(rect);
         painter.setBrush(Qt::black);
-        QRectF fuseRect(centerX - 2, m_rect.top(), 4, 8);
+        QRectF fuseRect(centerX - 2, rect.top(), 4, 8);
         painter.drawRect(fuseRect);
         break;
     }
 
     case PowerUpType::SHIELD: {
         // Draw shield
-        painter.drawEllipse(m_rect);
+        painter.drawEllipse(rect);
         painter.setPen(QPen(Qt::white, 3));
         painter.setBrush(Qt::NoBrush);
-        painter.drawEllipse(m_rect.adjusted(4, 4, -4, -4));
+        painter.drawEllipse(rect.adjusted(4, 4, -4, -4));
         break;
     }
 
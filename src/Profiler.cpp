@@ -0,0 +1,114 @@
+#include "../include/Profiler.hpp"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+namespace {
+// Identifiants de piste dans la trace : simulation et rendu séparés
+constexpr int TRACE_PID = 1;
+constexpr int TRACE_TID_SIMULATION = 1;
+constexpr int TRACE_TID_RENDER = 2;
+}
+
+Profiler::Profiler()
+    : m_enabled(true)
+    , m_frameIndex(0)
+    , m_frameHead(0)
+    , m_eventHead(0)
+{
+    m_clock.start();
+    m_frames.reserve(FRAME_HISTORY);
+    m_events.reserve(EVENT_HISTORY);
+    m_frames.push_back(FrameProfile());
+}
+
+void Profiler::beginFrame() {
+    if (!m_enabled) return;
+
+    m_frameIndex++;
+    if (m_frames.size() < static_cast<size_t>(FRAME_HISTORY)) {
+        m_frames.push_back(FrameProfile());
+        m_frameHead = m_frames.size() - 1;
+    } else {
+        m_frameHead = (m_frameHead + 1) % FRAME_HISTORY;
+        m_frames[m_frameHead] = FrameProfile();
+    }
+}
+
+void Profiler::record(ProfilePhase phase, qint64 startNs, qint64 durationNs) {
+    const int index = static_cast<int>(phase);
+    m_frames[m_frameHead].phaseNs[index] += durationNs;
+    m_totals.totalNs[index] += durationNs;
+    m_totals.calls[index]++;
+
+    const ProfileEvent event{phase, m_frameIndex, startNs, durationNs};
+    if (m_events.size() < static_cast<size_t>(EVENT_HISTORY)) {
+        m_events.push_back(event);
+    } else {
+        m_events[m_eventHead] = event;
+    }
+    m_eventHead = (m_eventHead + 1) % EVENT_HISTORY;
+}
+
+const FrameProfile& Profiler::frameAt(int index) const {
+    // Tant que le tampon n'est pas plein, la plus ancienne frame est en tête
+    if (m_frames.size() < static_cast<size_t>(FRAME_HISTORY)) {
+        return m_frames[index];
+    }
+    return m_frames[(m_frameHead + 1 + index) % FRAME_HISTORY];
+}
+
+bool Profiler::writeChromeTrace(const QString& path, int frameCount) const {
+    const quint32 firstFrame = m_frameIndex >= static_cast<quint32>(frameCount)
+                               ? m_frameIndex - frameCount + 1 : 0;
+
+    QJsonArray traceEvents;
+    const size_t count = m_events.size();
+    const size_t oldest = count < static_cast<size_t>(EVENT_HISTORY) ? 0 : m_eventHead;
+
+    for (size_t i = 0; i < count; i++) {
+        const ProfileEvent& event = m_events[(oldest + i) % count];
+        if (event.frame < firstFrame) continue;
+
+        QJsonObject object;
+        object["name"] = phaseName(event.phase);
+        object["cat"] = event.phase == ProfilePhase::PAINT ? "render" : "simulation";
+        object["ph"] = "X";
+        object["ts"] = event.startNs / 1000.0;      // µs
+        object["dur"] = event.durationNs / 1000.0;
+        object["pid"] = TRACE_PID;
+        object["tid"] = event.phase == ProfilePhase::PAINT ? TRACE_TID_RENDER : TRACE_TID_SIMULATION;
+        object["args"] = QJsonObject{{"frame", static_cast<qint64>(event.frame)}};
+        traceEvents.append(object);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Impossible d'écrire la trace:" << path;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    qDebug() << "Trace exportée:" << traceEvents.size() << "événements dans" << path;
+    return true;
+}
+
+const char* Profiler::phaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::TICK: return "tick";
+        case ProfilePhase::PLAYER_UPDATE: return "player_update";
+        case ProfilePhase::UPDATE_ENEMIES: return "update_enemies";
+        case ProfilePhase::UPDATE_BULLETS: return "update_bullets";
+        case ProfilePhase::UPDATE_POWERUPS: return "update_powerups";
+        case ProfilePhase::CHECK_COLLISIONS: return "check_collisions";
+        case ProfilePhase::CLEANUP_INACTIVE: return "cleanup_inactive";
+        case ProfilePhase::PAINT: return "paint";
+        case ProfilePhase::COUNT: break;
+    }
+    return "unknown";
+}
@@ -0,0 +1,305 @@
+#include "../include/ReplayFile.hpp"
+#include "../include/GameEngine.hpp"
+#include "../include/BotPlayer.hpp"
+#include "../include/Constants.hpp"
+#include "../include/WireFormat.hpp"
+#include <cstring>
+
+using namespace ReplayFormat;
+using WireFormat::putLittleEndian;
+
+// --- Écriture ---
+
+ReplayWriter::ReplayWriter(int keyframeInterval)
+    : m_interval(qMax(1, keyframeInterval))
+    , m_ticks(0)
+    , m_end(DATA_OFFSET)
+    , m_indexBlock(0)
+{
+}
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+bool ReplayWriter::fail(const QString& message) {
+    m_error = message;
+    return false;
+}
+
+bool ReplayWriter::open(const QString& path, quint32 seed, QString* error) {
+    close();
+    m_file.setFileName(path);
+    // Sans tampon : chaque écriture atteint le fichier, et donc les lecteurs
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        if (error) *error = m_file.errorString();
+        return fail(m_file.errorString());
+    }
+
+    // En-tête et table d'index de premier niveau, vides
+    QByteArray header(DATA_OFFSET, '\0');
+    std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+    putLittleEndian(header.data() + HEADER_VERSION, VERSION);
+    putLittleEndian(header.data() + HEADER_INTERVAL, static_cast<quint32>(m_interval));
+    putLittleEndian(header.data() + HEADER_TICK_RATE, static_cast<quint32>(GameConstants::SIMULATION_RATE));
+    putLittleEndian(header.data() + HEADER_SEED, seed);
+    putLittleEndian(header.data() + HEADER_DATA_END, static_cast<quint64>(DATA_OFFSET));
+    if (m_file.write(header) != header.size() || !m_file.flush()) {
+        if (error) *error = m_file.errorString();
+        return fail(m_file.errorString());
+    }
+
+    m_ticks = 0;
+    m_end = DATA_OFFSET;
+    m_indexBlock = 0;
+    m_previous.clear();
+    return true;
+}
+
+void ReplayWriter::close() {
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool ReplayWriter::recordTick(const GameEngine& engine) {
+    thread_local WorldState current;
+    current.capture(engine);
+    return append(current);
+}
+
+bool ReplayWriter::append(const WorldState& state) {
+    if (!m_file.isOpen()) return false;
+
+    if (m_ticks % m_interval == 0) {
+        const quint32 keyframe = m_ticks / m_interval;
+        const quint32 slot = keyframe % INDEX_FANOUT;
+        const quint32 block = keyframe / INDEX_FANOUT;
+        if (block >= static_cast<quint32>(INDEX_FANOUT)) {
+            return fail("Replay trop long pour l'index");
+        }
+
+        // Nouveau bloc d'index, référencé par la table de l'en-tête
+        if (slot == 0) {
+            const qint64 blockOffset = m_end + RECORD_HEADER_SIZE;
+            if (!appendRecord(RECORD_INDEX, QByteArray(INDEX_FANOUT * 8, '\0'))) return false;
+            char offset[8];
+            putLittleEndian(offset, static_cast<quint64>(blockOffset));
+            if (!writeAt(TOP_INDEX_OFFSET + block * 8, offset, 8)) return false;
+            m_indexBlock = blockOffset;
+        }
+
+        const qint64 recordOffset = m_end;
+        SnapshotCodec::encodeDelta(m_empty, state, m_payload);
+        if (!appendRecord(RECORD_KEYFRAME, m_payload)) return false;
+        char offset[8];
+        putLittleEndian(offset, static_cast<quint64>(recordOffset));
+        if (!writeAt(m_indexBlock + slot * 8, offset, 8)) return false;
+    } else {
+        SnapshotCodec::encodeDelta(m_previous, state, m_payload);
+        if (!appendRecord(RECORD_DELTA, m_payload)) return false;
+    }
+    m_previous = state;
+    m_ticks++;
+
+    // Fin des données puis nombre de ticks : un lecteur qui voit le
+    // nouveau compte trouve forcément les enregistrements correspondants
+    char end[8];
+    putLittleEndian(end, static_cast<quint64>(m_end));
+    char ticks[4];
+    putLittleEndian(ticks, m_ticks);
+    if (!writeAt(HEADER_DATA_END, end, 8) || !writeAt(HEADER_TICKS, ticks, 4)) return false;
+    return m_file.flush() || fail(m_file.errorString());
+}
+
+bool ReplayWriter::appendRecord(RecordType type, const QByteArray& payload) {
+    m_record.clear();
+    char size[4];
+    putLittleEndian(size, static_cast<quint32>(payload.size()));
+    m_record.append(size, 4);
+    m_record.append(static_cast<char>(type));
+    m_record.append(payload);
+
+    if (!writeAt(m_end, m_record.constData(), m_record.size())) return false;
+    m_end += m_record.size();
+    return true;
+}
+
+bool ReplayWriter::writeAt(qint64 offset, const char* data, int size) {
+    if (!m_file.seek(offset) || m_file.write(data, size) != size) {
+        return fail(m_file.errorString());
+    }
+    return true;
+}
+
+bool ReplayWriter::recordBotMatch(const QString& path, quint32 seed, int ticks, int keyframeInterval, QString* error) {
+    ReplayWriter writer(keyframeInterval);
+    if (!writer.open(path, seed, error)) return false;
+
+    GameEngine engine;
+    engine.setSeed(seed);
+    engine.setPreloadNextLevel(false);   // Partie relancée à la fin, pas de niveau suivant
+    BotPlayer bot(seed);
+
+    // Comme BatchRunner : la boucle cadence les ticks ; partie relancée à la fin
+    for (int tick = 0; tick < ticks; tick++) {
+        if (engine.getState() != GameState::PLAYING) {
+            engine.startHeadless();
+        }
+        bot.think(engine);
+        engine.stepTick();
+        if (!writer.recordTick(engine)) {
+            if (error) *error = writer.errorString();
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Lecture ---
+
+ReplayReader::ReplayReader()
+    : m_data(nullptr)
+    , m_mapped(0)
+    , m_ticks(0)
+    , m_dataEnd(0)
+    , m_interval(1)
+    , m_tickRate(GameConstants::SIMULATION_RATE)
+    , m_seed(0)
+    , m_cursor(0)
+    , m_next(0)
+    , m_lastSeekDeltas(0)
+{
+}
+
+ReplayReader::~ReplayReader() {
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+}
+
+bool ReplayReader::open(const QString& path, QString* error) {
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+    if (!map(m_file.size()) || m_mapped < DATA_OFFSET || std::memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0 ||
+        WireFormat::readU32(m_data + HEADER_VERSION) != VERSION) {
+        if (error) *error = "Fichier de replay invalide";
+        return false;
+    }
+
+    m_interval = qMax<int>(1, WireFormat::readU32(m_data + HEADER_INTERVAL));
+    m_tickRate = static_cast<int>(WireFormat::readU32(m_data + HEADER_TICK_RATE));
+    m_seed = WireFormat::readU32(m_data + HEADER_SEED);
+    m_cursor = 0;
+    m_next = 0;
+    return refresh();
+}
+
+bool ReplayReader::map(qint64 size) {
+    if (m_data && size <= m_mapped) return true;
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+        m_data = nullptr;
+        m_mapped = 0;
+    }
+    m_data = m_file.map(0, size);
+    if (!m_data) return false;
+    m_mapped = size;
+    return true;
+}
+
+bool ReplayReader::refresh() {
+    if (!m_data) return false;
+
+    // Nombre de ticks d'abord : la fin des données lue ensuite le couvre
+    const quint32 ticks = WireFormat::readU32(m_data + HEADER_TICKS);
+    const qint64 dataEnd = static_cast<qint64>(WireFormat::readU64(m_data + HEADER_DATA_END));
+    if (dataEnd > m_mapped && !map(m_file.size())) return false;
+    if (dataEnd > m_mapped) return false;
+
+    m_ticks = ticks;
+    m_dataEnd = dataEnd;
+    return true;
+}
+
+quint64 ReplayReader::readU64(qint64 offset) const {
+    if (offset < 0 || offset + 8 > m_dataEnd) return 0;
+    return WireFormat::readU64(m_data + offset);
+}
+
+bool ReplayReader::readRecord(qint64& offset, RecordType& type, const char*& payload, int& size) const {
+    for (;;) {
+        if (offset < DATA_OFFSET || offset + RECORD_HEADER_SIZE > m_dataEnd) return false;
+        const quint32 length = WireFormat::readU32(m_data + offset);
+        const quint8 kind = m_data[offset + 4];
+        const qint64 next = offset + RECORD_HEADER_SIZE + length;
+        if (next > m_dataEnd) return false;
+
+        if (kind != RECORD_INDEX) {
+            type = static_cast<RecordType>(kind);
+            payload = reinterpret_cast<const char*>(m_data + offset + RECORD_HEADER_SIZE);
+            size = static_cast<int>(length);
+            offset = next;
+            return true;
+        }
+        offset = next;
+    }
+}
+
+bool ReplayReader::applyRecord(RecordType type, const char* payload, int size) {
+    const WorldState& baseline = type == RECORD_KEYFRAME ? m_empty : m_state;
+    if (type != RECORD_KEYFRAME && type != RECORD_DELTA) return false;
+    if (!SnapshotCodec::applyDelta(baseline, payload, size, m_scratch)) return false;
+    std::swap(m_state, m_scratch);
+    return true;
+}
+
+bool ReplayReader::seek(quint32 tick) {
+    if (tick >= m_ticks && (!refresh() || tick >= m_ticks)) return false;
+
+    // Index : table de l'en-tête, puis bloc, puis image clé
+    const quint32 keyframe = tick / m_interval;
+    const quint64 block = readU64(TOP_INDEX_OFFSET + (keyframe / INDEX_FANOUT) * 8);
+    qint64 offset = static_cast<qint64>(readU64(static_cast<qint64>(block) + (keyframe % INDEX_FANOUT) * 8));
+
+    RecordType type;
+    const char* payload;
+    int size;
+    if (block == 0 || !readRecord(offset, type, payload, size) || type != RECORD_KEYFRAME ||
+        !applyRecord(type, payload, size)) {
+        m_cursor = 0;
+        return false;
+    }
+
+    const quint32 first = keyframe * m_interval;
+    for (quint32 current = first + 1; current <= tick; current++) {
+        if (!readRecord(offset, type, payload, size) || !applyRecord(type, payload, size)) {
+            m_cursor = 0;
+            return false;
+        }
+    }
+
+    m_lastSeekDeltas = static_cast<int>(tick - first);
+    m_cursor = offset;
+    m_next = tick + 1;
+    return true;
+}
+
+bool ReplayReader::readNext() {
+    if (m_next >= m_ticks && (!refresh() || m_next >= m_ticks)) return false;
+    if (m_cursor == 0) return seek(m_next);
+
+    RecordType type;
+    const char* payload;
+    int size;
+    qint64 offset = m_cursor;
+    if (!readRecord(offset, type, payload, size) || !applyRecord(type, payload, size)) {
+        return false;
+    }
+    m_cursor = offset;
+    m_next++;
+    return true;
+}
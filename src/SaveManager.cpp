@@ -72,3 +72,14 @@ int SaveManager::getSfxVolume() const
 {
     return m_settings.value("audio/sfxVolume", 50).toInt();
 }
+
+// --- Software Rendering ---
+void SaveManager::setSoftwareRendering(bool enabled)
+{
+    m_settings.setValue("render/software", enabled);
+}
+
+bool SaveManager::getSoftwareRendering() const
+{
+    return m_settings.value("render/software", false).toBool();
+}
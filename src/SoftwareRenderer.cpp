@@ -0,0 +1,295 @@
+#include "../include/SoftwareRenderer.hpp"
+#include "../include/PixelKernels.hpp"
+#include "../include/Constants.hpp"
+#include <QPainter>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+// Familles de sprites (octet de poids fort de la clé du cache)
+enum SpriteKind : quint64 {
+    SPRITE_BLOCK = 1,
+    SPRITE_TANK = 2,
+    SPRITE_SHIELD = 3,
+    SPRITE_BULLET = 4,
+    SPRITE_POWERUP = 5
+};
+
+// Niveaux d'opacité du bouclier gardés en cache
+constexpr int SHIELD_ALPHA_STEP = 16;
+
+quint64 spriteKey(SpriteKind kind, quint64 variant, quint32 color = 0) {
+    return (static_cast<quint64>(kind) << 56) | (variant << 32) | color;
+}
+
+QPoint roundedPosition(const QPointF& position) {
+    return QPoint(qRound(position.x()), qRound(position.y()));
+}
+}
+
+SoftwareRenderer::SoftwareRenderer()
+    : m_framebuffer(GameConstants::GAME_AREA_WIDTH, GameConstants::GAME_AREA_HEIGHT,
+                    QImage::Format_ARGB32_Premultiplied)
+    , m_background(QColor(Colors::BACKGROUND).rgba())
+{
+    m_framebuffer.fill(QColor(Colors::BACKGROUND));
+    qDebug() << "Rendu logiciel actif - noyaux:" << PixelKernels::activeImplementation();
+}
+
+void SoftwareRenderer::clear(const QRegion& region) {
+    const QRect bounds = m_framebuffer.rect();
+    for (const QRect& dirtyRect : region) {
+        fill(dirtyRect.intersected(bounds), m_background);
+    }
+}
+
+void SoftwareRenderer::render(const GameEngine& engine, qreal alpha, const QRegion& region) {
+    const QRect bounds = m_framebuffer.rect();
+    const QRect area = region.boundingRect().intersected(bounds);
+    if (area.isEmpty()) return;
+
+    // Un seul parcours des entités pour toute la région ; un sprite ajouté au
+    // cache peut déplacer les autres, la liste est alors refaite
+    const qsizetype cached = m_sprites.size();
+    collect(engine, alpha, area);
+    if (m_sprites.size() != cached) {
+        collect(engine, alpha, area);
+    }
+
+    for (const QRect& dirtyRect : region) {
+        const QRect clip = dirtyRect.intersected(bounds);
+        if (clip.isEmpty()) continue;
+
+        fill(clip, m_background);
+
+        // Entités des cases touchées, chacune une fois, dans l'ordre de peinture
+        const QRect cells = cellSpan(clip);
+        m_visible.clear();
+        for (int row = cells.top(); row <= cells.bottom(); row++) {
+            for (int column = cells.left(); column <= cells.right(); column++) {
+                const auto& bin = m_bins[row * GameConstants::GRID_WIDTH + column];
+                m_visible.insert(m_visible.end(), bin.begin(), bin.end());
+            }
+        }
+        std::sort(m_visible.begin(), m_visible.end());
+        m_visible.erase(std::unique(m_visible.begin(), m_visible.end()), m_visible.end());
+
+        for (int index : m_visible) {
+            blit(*m_items[index].sprite, m_items[index].anchor, clip);
+        }
+    }
+}
+
+void SoftwareRenderer::collect(const GameEngine& engine, qreal alpha, const QRect& area) {
+    m_items.clear();
+    m_bins.resize(static_cast<size_t>(GameConstants::GRID_WIDTH) * GameConstants::GRID_HEIGHT);
+    for (auto& bin : m_bins) {
+        bin.clear();
+    }
+
+    // Même ordre que GameWidget::renderGame
+    for (const auto& block : engine.getBlocks()) {
+        if (block->isActive()) {
+            addItem(blockSprite(*block), roundedPosition(block->getPosition()), area);
+        }
+    }
+
+    for (const auto& powerUp : engine.getPowerUps()) {
+        if (powerUp->isActive() && !powerUp->isBlinkHidden()) {
+            addItem(powerUpSprite(*powerUp), roundedPosition(powerUp->getPosition()), area);
+        }
+    }
+
+    for (const auto& bullet : engine.getBullets()) {
+        if (bullet->isActive()) {
+            addItem(bulletSprite(*bullet), roundedPosition(bullet->getInterpolatedPosition(alpha)), area);
+        }
+    }
+
+    for (const auto& enemy : engine.getEnemies()) {
+        addTank(*enemy, alpha, area);
+    }
+
+    if (engine.getPartner()) {
+        addTank(*engine.getPartner(), alpha, area);
+    }
+    if (engine.getPlayer()) {
+        addTank(*engine.getPlayer(), alpha, area);
+    }
+}
+
+void SoftwareRenderer::addItem(const Sprite& sprite, const QPoint& anchor, const QRect& area) {
+    const QRect visible = QRect(anchor + sprite.offset, sprite.image.size()).intersected(area);
+    if (visible.isEmpty()) return;
+
+    const int index = static_cast<int>(m_items.size());
+    m_items.push_back({&sprite, anchor});
+
+    const QRect cells = cellSpan(visible);
+    for (int row = cells.top(); row <= cells.bottom(); row++) {
+        for (int column = cells.left(); column <= cells.right(); column++) {
+            m_bins[row * GameConstants::GRID_WIDTH + column].push_back(index);
+        }
+    }
+}
+
+QRect SoftwareRenderer::cellSpan(const QRect& rect) const {
+    // rect est dans le framebuffer : les cases restent dans la grille
+    const int size = GameConstants::CELL_SIZE;
+    return QRect(QPoint(rect.left() / size, rect.top() / size),
+                 QPoint(rect.right() / size, rect.bottom() / size));
+}
+
+void SoftwareRenderer::dim(const QRegion& region, const QColor& color) {
+    const quint32 premultiplied = qPremultiply(color.rgba());
+    const QRect bounds = m_framebuffer.rect();
+
+    for (const QRect& dirtyRect : region) {
+        const QRect clip = dirtyRect.intersected(bounds);
+        for (int y = clip.top(); y <= clip.bottom(); y++) {
+            quint32* line = reinterpret_cast<quint32*>(m_framebuffer.scanLine(y)) + clip.left();
+            PixelKernels::blendSolidSpan(line, clip.width(), premultiplied);
+        }
+    }
+}
+
+void SoftwareRenderer::addTank(const Tank& tank, qreal alpha, const QRect& area) {
+    if (!tank.isActive()) return;
+
+    const QPointF position = tank.getInterpolatedPosition(alpha);
+    if (tank.hasShield()) {
+        const QPointF center = position + (tank.getRect().center() - tank.getPosition());
+        addItem(shieldSprite(tank.getShieldAlpha()), roundedPosition(center), area);
+    }
+    addItem(tankSprite(tank), roundedPosition(position), area);
+}
+
+SoftwareRenderer::Sprite SoftwareRenderer::buildSprite(const QRectF& bounds, const QPointF& anchor,
+                                                       const std::function<void(QPainter&)>& paint) const {
+    const QRect aligned = bounds.toAlignedRect();
+
+    Sprite sprite;
+    sprite.image = QImage(aligned.size(), QImage::Format_ARGB32_Premultiplied);
+    sprite.image.fill(Qt::transparent);
+    sprite.offset = aligned.topLeft() - roundedPosition(anchor);
+
+    // L'antialiasing n'est payé qu'une fois, à la création du sprite
+    QPainter painter(&sprite.image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(-aligned.topLeft());
+    paint(painter);
+    painter.end();
+
+    // Un sprite entièrement opaque se recopie sans composition
+    sprite.opaque = true;
+    for (int y = 0; y < sprite.image.height() && sprite.opaque; y++) {
+        const quint32* line = reinterpret_cast<const quint32*>(sprite.image.constScanLine(y));
+        for (int x = 0; x < sprite.image.width(); x++) {
+            if ((line[x] >> 24) != 255) {
+                sprite.opaque = false;
+                break;
+            }
+        }
+    }
+
+    return sprite;
+}
+
+const SoftwareRenderer::Sprite& SoftwareRenderer::blockSprite(const Block& block) {
+    const quint64 key = spriteKey(SPRITE_BLOCK, static_cast<quint64>(block.getBlockType()));
+    auto it = m_sprites.find(key);
+    if (it == m_sprites.end()) {
+        // Tuile exactement de la taille de la case : opaque sauf pour les arbres
+        Block prototype(FixedPoint(), block.getBlockType());
+        it = m_sprites.insert(key, buildSprite(prototype.getRect(), QPointF(0, 0),
+                                               [&prototype](QPainter& painter) {
+                                                   prototype.render(painter);
+                                               }));
+    }
+    return it.value();
+}
+
+const SoftwareRenderer::Sprite& SoftwareRenderer::tankSprite(const Tank& tank) {
+    const quint64 key = spriteKey(SPRITE_TANK, static_cast<quint64>(tank.getDirection()),
+                                  tank.getColor().rgba());
+    auto it = m_sprites.find(key);
+    if (it == m_sprites.end()) {
+        it = m_sprites.insert(key, buildSprite(tank.getRenderBounds(), tank.getPosition(),
+                                               [&tank](QPainter& painter) {
+                                                   tank.renderBody(painter);
+                                               }));
+    }
+    return it.value();
+}
+
+const SoftwareRenderer::Sprite& SoftwareRenderer::shieldSprite(int alpha) {
+    const int level = qBound(0, alpha / SHIELD_ALPHA_STEP, 255 / SHIELD_ALPHA_STEP);
+    const quint64 key = spriteKey(SPRITE_SHIELD, static_cast<quint64>(level));
+    auto it = m_sprites.find(key);
+    if (it == m_sprites.end()) {
+        const int spriteAlpha = qMin(255, level * SHIELD_ALPHA_STEP + SHIELD_ALPHA_STEP / 2);
+        const QRectF bounds(-24, -24, 48, 48);
+        it = m_sprites.insert(key, buildSprite(bounds, QPointF(0, 0),
+                                               [spriteAlpha](QPainter& painter) {
+                                                   Tank::renderShield(painter, QPointF(0, 0), spriteAlpha);
+                                               }));
+    }
+    return it.value();
+}
+
+const SoftwareRenderer::Sprite& SoftwareRenderer::bulletSprite(const Bullet& bullet) {
+    const quint64 key = spriteKey(SPRITE_BULLET, 0, bullet.getColor().rgba());
+    auto it = m_sprites.find(key);
+    if (it == m_sprites.end()) {
+        Bullet prototype(bullet);
+        prototype.setPosition(FixedPoint());
+        it = m_sprites.insert(key, buildSprite(prototype.getRenderBounds(), QPointF(0, 0),
+                                               [&prototype](QPainter& painter) {
+                                                   prototype.render(painter);
+                                               }));
+    }
+    return it.value();
+}
+
+const SoftwareRenderer::Sprite& SoftwareRenderer::powerUpSprite(const PowerUp& powerUp) {
+    const quint64 key = spriteKey(SPRITE_POWERUP, static_cast<quint64>(powerUp.getPowerUpType()));
+    auto it = m_sprites.find(key);
+    if (it == m_sprites.end()) {
+        // Prototype neuf : jamais dans une phase de clignotement
+        PowerUp prototype(FixedPoint(), powerUp.getPowerUpType());
+        it = m_sprites.insert(key, buildSprite(prototype.getRenderBounds(), QPointF(0, 0),
+                                               [&prototype](QPainter& painter) {
+                                                   prototype.render(painter);
+                                               }));
+    }
+    return it.value();
+}
+
+void SoftwareRenderer::blit(const Sprite& sprite, const QPoint& anchor, const QRect& clip) {
+    const QRect target(anchor + sprite.offset, sprite.image.size());
+    const QRect visible = target.intersected(clip);
+    if (visible.isEmpty()) return;
+
+    const int sourceX = visible.left() - target.left();
+    const int sourceY = visible.top() - target.top();
+
+    for (int row = 0; row < visible.height(); row++) {
+        quint32* dst = reinterpret_cast<quint32*>(m_framebuffer.scanLine(visible.top() + row))
+                       + visible.left();
+        const quint32* src = reinterpret_cast<const quint32*>(sprite.image.constScanLine(sourceY + row))
+                             + sourceX;
+
+        if (sprite.opaque) {
+            PixelKernels::copySpan(dst, src, visible.width());
+        } else {
+            PixelKernels::blendSpan(dst, src, visible.width());
+        }
+    }
+}
+
+void SoftwareRenderer::fill(const QRect& rect, quint32 color) {
+    for (int y = rect.top(); y <= rect.bottom(); y++) {
+        quint32* line = reinterpret_cast<quint32*>(m_framebuffer.scanLine(y)) + rect.left();
+        PixelKernels::fillSpan(line, rect.width(), color);
+    }
+}
@@ -1,51 +1,91 @@
 #include "../include/SoundManager.hpp"
 #include "../include/SaveManager.hpp"
-#include <QSoundEffect>
-#include <QUrl>
+#include "../include/AudioMixer.hpp"
+#include "../include/Constants.hpp"
+#include <QDebug>
+
+namespace {
+// Priorité de chaque événement, du moins au plus important : un son
+// prioritaire peut voler la voix d'un son moins important
+struct SoundDefinition {
+    GameEventType type;
+    int priority;
+};
+
+constexpr SoundDefinition SOUND_DEFINITIONS[] = {
+    {GameEventType::ENEMY_SHOOT, 0},
+    {GameEventType::BLOCK_DESTROYED, 1},
+    {GameEventType::ENEMY_SPAWN, 1},
+    {GameEventType::PLAYER_SHOOT, 2},
+    {GameEventType::ENEMY_DESTROYED, 2},
+    {GameEventType::POWERUP_HEALTH, 3},
+    {GameEventType::POWERUP_BOMB, 3},
+    {GameEventType::POWERUP_SHIELD, 3},
+    {GameEventType::PLAYER_HIT, 4},
+    {GameEventType::BASE_DESTROYED, 5}
+};
+}
 
 SoundManager::SoundManager(QObject* parent)
-    : QObject(parent), m_enabled(true), m_volume(50)
+    : QObject(parent), m_enabled(true), m_volume(50), m_mixer(std::make_unique<AudioMixer>())
+    , m_loadedSounds(0)
 {
     loadSounds();
+    // Sans aucun son, inutile d'ouvrir la sortie audio
+    if (m_loadedSounds > 0) {
+        m_mixer->start();
+    }
 }
 
+SoundManager::~SoundManager() = default;
+
 void SoundManager::initialize() {
     m_enabled = SaveManager::instance().getSoundEnabled();
     m_volume = SaveManager::instance().getSfxVolume();
-
-    for (auto sound : m_sounds)
-        sound->setVolume(m_enabled ? m_volume / 100.0f : 0.0f);
+    applyVolume();
 }
 
 void SoundManager::loadSounds() {
-    QStringList soundNames = {"shoot", "explosion", "powerup"};
-
-    for (const QString& name : soundNames) {
-        QSoundEffect* effect = new QSoundEffect(this);
-        effect->setSource(QUrl::fromLocalFile(":/sounds/" + name + ".wav"));
-        effect->setVolume(m_volume / 100.0f);
-        m_sounds.insert(name, effect);
+    // Décodage complet au démarrage : rien n'est lu sur disque en jeu
+    for (const SoundDefinition& sound : SOUND_DEFINITIONS) {
+        const int id = m_mixer->loadWav(QString(":/sounds/") + gameEventName(sound.type) + ".wav");
+        if (id >= 0) {
+            m_sounds[static_cast<int>(sound.type)] = SoundSlot{id, sound.priority};
+            m_loadedSounds++;
+        }
     }
+    qDebug() << "Sons chargés:" << m_loadedSounds;
 }
 
-void SoundManager::playSound(const QString& soundName) {
-    if (!m_enabled) return;
-    if (m_sounds.contains(soundName)) {
-        m_sounds[soundName]->stop();
-        m_sounds[soundName]->play();
+void SoundManager::playSound(GameEventType type, qreal x) {
+    if (!m_enabled || type >= GameEventType::COUNT) return;
+
+    const SoundSlot& slot = m_sounds[static_cast<int>(type)];
+    if (slot.id < 0) return;
+
+    const float pan = x < 0 ? 0.0f
+                            : static_cast<float>(x / GameConstants::GAME_AREA_WIDTH * 2.0 - 1.0);
+    m_mixer->play(slot.id, 1.0f, pan, slot.priority);
+}
+
+void SoundManager::onGameEvents(const GameEventList& events) {
+    for (const GameEvent& event : events) {
+        playSound(event.type, event.position.x());
     }
 }
 
 void SoundManager::setEnabled(bool enabled) {
     m_enabled = enabled;
     SaveManager::instance().setSoundEnabled(enabled);
-    for (auto sound : m_sounds)
-        sound->setVolume(enabled ? m_volume / 100.0f : 0.0f);
+    applyVolume();
 }
 
 void SoundManager::setVolume(int volume) {
     m_volume = volume;
     SaveManager::instance().setSfxVolume(volume);
-    for (auto sound : m_sounds)
-        sound->setVolume(m_enabled ? m_volume / 100.0f : 0.0f);
+    applyVolume();
+}
+
+void SoundManager::applyVolume() {
+    m_mixer->setMasterGain(m_enabled ? m_volume / 100.0f : 0.0f);
 }
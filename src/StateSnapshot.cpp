@@ -0,0 +1,297 @@
+#include "../include/StateSnapshot.hpp"
+#include "../include/GameEngine.hpp"
+#include <algorithm>
+
+namespace {
+// Champs présents dans une entrée modifiée
+constexpr quint8 FIELD_X = 0x01;
+constexpr quint8 FIELD_Y = 0x02;
+constexpr quint8 FIELD_DIRECTION = 0x04;
+constexpr quint8 FIELD_HEALTH = 0x08;
+constexpr quint8 FIELD_FLAGS = 0x10;
+constexpr quint8 FIELD_NEW = 0x80;     // Entité complète : type et position absolue
+
+void writeVarint(QByteArray& out, quint32 value) {
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+quint32 zigzag(qint32 value) {
+    return (static_cast<quint32>(value) << 1) ^ static_cast<quint32>(value >> 31);
+}
+
+qint32 unzigzag(quint32 value) {
+    return static_cast<qint32>(value >> 1) ^ -static_cast<qint32>(value & 1);
+}
+
+// Lecture bornée : toute lecture hors du tampon met ok à faux
+struct Reader {
+    const quint8* data;
+    const quint8* end;
+    bool ok = true;
+
+    quint8 byte() {
+        if (data >= end) { ok = false; return 0; }
+        return *data++;
+    }
+    quint32 varint() {
+        quint32 value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            const quint8 part = byte();
+            value |= static_cast<quint32>(part & 0x7F) << shift;
+            if (!(part & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+    qint32 signedVarint() { return unzigzag(varint()); }
+};
+
+void writeFull(QByteArray& out, const EntityState& entity) {
+    out.append(static_cast<char>(FIELD_NEW));
+    out.append(static_cast<char>(entity.type));
+    writeVarint(out, zigzag(entity.x));
+    writeVarint(out, zigzag(entity.y));
+    out.append(static_cast<char>(entity.direction));
+    out.append(static_cast<char>(entity.health));
+    out.append(static_cast<char>(entity.flags));
+}
+
+// Faux si rien n'a changé
+bool writeChanges(QByteArray& out, const EntityState& before, const EntityState& after) {
+    if (before.type != after.type) {
+        writeFull(out, after);
+        return true;
+    }
+
+    quint8 mask = 0;
+    if (after.x != before.x) mask |= FIELD_X;
+    if (after.y != before.y) mask |= FIELD_Y;
+    if (after.direction != before.direction) mask |= FIELD_DIRECTION;
+    if (after.health != before.health) mask |= FIELD_HEALTH;
+    if (after.flags != before.flags) mask |= FIELD_FLAGS;
+    if (mask == 0) return false;
+
+    out.append(static_cast<char>(mask));
+    if (mask & FIELD_X) writeVarint(out, zigzag(after.x - before.x));
+    if (mask & FIELD_Y) writeVarint(out, zigzag(after.y - before.y));
+    if (mask & FIELD_DIRECTION) out.append(static_cast<char>(after.direction));
+    if (mask & FIELD_HEALTH) out.append(static_cast<char>(after.health));
+    if (mask & FIELD_FLAGS) out.append(static_cast<char>(after.flags));
+    return true;
+}
+
+EntityState tankState(const Tank& tank, quint8 flags) {
+    EntityState state;
+    state.id = tank.getId();
+    state.type = static_cast<quint8>(tank.getType());
+    state.direction = static_cast<quint8>(tank.getDirection());
+    state.health = static_cast<quint8>(qBound(0, tank.getHealth(), 255));
+    state.flags = flags;
+    state.x = tank.getBox().x;
+    state.y = tank.getBox().y;
+    return state;
+}
+
+EntityState boxState(const Entity& entity) {
+    EntityState state;
+    state.id = entity.getId();
+    state.type = static_cast<quint8>(entity.getType());
+    state.x = entity.getBox().x;
+    state.y = entity.getBox().y;
+    return state;
+}
+}
+
+void WorldState::capture(const GameEngine& engine) {
+    tick = static_cast<quint32>(engine.getTickCount());
+    state = static_cast<quint8>(engine.getState());
+    score = engine.getScore();
+    enemiesRemaining = engine.getEnemiesRemaining();
+
+    // La capacité du vecteur est conservée d'un instantané à l'autre
+    entities.clear();
+    if (engine.getPlayer() && engine.getPlayer()->isActive()) {
+        entities.push_back(tankState(*engine.getPlayer(), 0));
+    }
+    if (engine.getPartner() && engine.getPartner()->isActive()) {
+        entities.push_back(tankState(*engine.getPartner(), EntityState::FLAG_PARTNER));
+    }
+    for (const auto& enemy : engine.getEnemies()) {
+        if (enemy->isActive()) entities.push_back(tankState(*enemy, 0));
+    }
+    for (const auto& bullet : engine.getBullets()) {
+        if (!bullet->isActive()) continue;
+        EntityState entity = boxState(*bullet);
+        entity.direction = static_cast<quint8>(bullet->getDirection());
+        entity.flags = bullet->isFromPlayer() ? EntityState::FLAG_FROM_PLAYER : 0;
+        entities.push_back(entity);
+    }
+    for (const auto& block : engine.getBlocks()) {
+        if (block->isActive()) entities.push_back(boxState(*block));
+    }
+    for (const auto& powerUp : engine.getPowerUps()) {
+        if (powerUp->isActive()) entities.push_back(boxState(*powerUp));
+    }
+
+    std::sort(entities.begin(), entities.end(), [](const EntityState& a, const EntityState& b) {
+        return a.id < b.id;
+    });
+}
+
+void WorldState::clear() {
+    tick = 0;
+    state = 0;
+    score = 0;
+    enemiesRemaining = 0;
+    entities.clear();
+}
+
+void SnapshotCodec::encodeDelta(const WorldState& baseline, const WorldState& current, QByteArray& out) {
+    // Tampons du thread réutilisés : pas d'allocation en régime établi
+    thread_local QByteArray removed;
+    thread_local QByteArray changed;
+    removed.clear();
+    changed.clear();
+    quint32 removedCount = 0;
+    quint32 changedCount = 0;
+    quint32 lastRemoved = 0;
+    quint32 lastChanged = 0;
+
+    auto beginChange = [&](quint32 id) {
+        writeVarint(changed, id - lastChanged);
+        lastChanged = id;
+        changedCount++;
+    };
+
+    // Fusion des deux listes triées
+    const auto& before = baseline.entities;
+    const auto& after = current.entities;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i].id < after[j].id)) {
+            writeVarint(removed, before[i].id - lastRemoved);
+            lastRemoved = before[i].id;
+            removedCount++;
+            i++;
+        } else if (i == before.size() || after[j].id < before[i].id) {
+            beginChange(after[j].id);
+            writeFull(changed, after[j]);
+            j++;
+        } else {
+            const int mark = changed.size();
+            const quint32 previousId = lastChanged;
+            beginChange(after[j].id);
+            if (!writeChanges(changed, before[i], after[j])) {
+                // Entité inchangée : on retire l'identifiant écrit
+                changed.truncate(mark);
+                lastChanged = previousId;
+                changedCount--;
+            }
+            i++;
+            j++;
+        }
+    }
+
+    out.clear();
+    writeVarint(out, current.tick);
+    out.append(static_cast<char>(current.state));
+    writeVarint(out, zigzag(current.score));
+    writeVarint(out, zigzag(current.enemiesRemaining));
+    writeVarint(out, removedCount);
+    out.append(removed);
+    writeVarint(out, changedCount);
+    out.append(changed);
+}
+
+bool SnapshotCodec::applyDelta(const WorldState& baseline, const char* data, int size, WorldState& out) {
+    Reader reader{reinterpret_cast<const quint8*>(data), reinterpret_cast<const quint8*>(data) + size};
+
+    out.tick = reader.varint();
+    out.state = reader.byte();
+    out.score = reader.signedVarint();
+    out.enemiesRemaining = reader.signedVarint();
+
+    thread_local std::vector<quint32> removedIds;
+    removedIds.clear();
+    const quint32 removedCount = reader.varint();
+    if (!reader.ok || removedCount > baseline.entities.size()) return false;
+    quint32 id = 0;
+    for (quint32 k = 0; k < removedCount && reader.ok; k++) {
+        id += reader.varint();
+        removedIds.push_back(id);
+    }
+
+    quint32 changedLeft = reader.varint();
+    if (!reader.ok) return false;
+
+    // Entrée modifiée en attente de fusion
+    quint32 changedId = 0;
+    bool hasChange = false;
+    auto nextChange = [&]() {
+        hasChange = changedLeft > 0;
+        if (hasChange) {
+            changedId += reader.varint();
+            changedLeft--;
+        }
+    };
+    // Une entité absente de la référence ne peut arriver que complète
+    auto readEntity = [&](EntityState& entity, bool known) {
+        const quint8 mask = reader.byte();
+        entity.id = changedId;
+        if (mask & FIELD_NEW) {
+            entity.type = reader.byte();
+            entity.x = reader.signedVarint();
+            entity.y = reader.signedVarint();
+            entity.direction = reader.byte();
+            entity.health = reader.byte();
+            entity.flags = reader.byte();
+            return;
+        }
+        if (!known) {
+            reader.ok = false;
+            return;
+        }
+        if (mask & FIELD_X) entity.x += reader.signedVarint();
+        if (mask & FIELD_Y) entity.y += reader.signedVarint();
+        if (mask & FIELD_DIRECTION) entity.direction = reader.byte();
+        if (mask & FIELD_HEALTH) entity.health = reader.byte();
+        if (mask & FIELD_FLAGS) entity.flags = reader.byte();
+    };
+
+    out.entities.clear();
+    size_t removedIndex = 0;
+    nextChange();
+    for (const EntityState& entity : baseline.entities) {
+        // Entités apparues avant celle-ci
+        while (hasChange && changedId < entity.id && reader.ok) {
+            EntityState added;
+            readEntity(added, false);
+            out.entities.push_back(added);
+            nextChange();
+        }
+
+        if (removedIndex < removedIds.size() && removedIds[removedIndex] == entity.id) {
+            removedIndex++;
+            continue;
+        }
+        EntityState kept = entity;
+        if (hasChange && changedId == entity.id) {
+            readEntity(kept, true);
+            nextChange();
+        }
+        out.entities.push_back(kept);
+    }
+    while (hasChange && reader.ok) {
+        EntityState added;
+        readEntity(added, false);
+        out.entities.push_back(added);
+        nextChange();
+    }
+
+    return reader.ok && removedIndex == removedIds.size() && reader.data == reader.end;
+}
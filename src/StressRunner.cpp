@@ -0,0 +1,191 @@
+#include "../include/StressRunner.hpp"
+#include "../include/Constants.hpp"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QDebug>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+StressRunner::StressRunner(const StressConfig& config)
+    : m_config(config)
+    , m_random(config.seed)
+{
+}
+
+bool StressRunner::isOpen(const FixedRect& box) const {
+    for (const auto& block : m_engine.getBlocks()) {
+        if (block->isActive() && box.intersects(block->getBox())) return false;
+    }
+    for (const auto& enemy : m_engine.getEnemies()) {
+        if (enemy->isActive() && box.intersects(enemy->getBox())) return false;
+    }
+    return !box.intersects(m_engine.getPlayer()->getBox());
+}
+
+FixedPoint StressRunner::randomOpenPosition(int size) {
+    // Quelques essais puis on accepte le chevauchement (monde saturé)
+    FixedPoint position;
+    for (int attempt = 0; attempt < 16; attempt++) {
+        position = FixedPoint::fromPixels(m_random.bounded(GameConstants::GAME_AREA_WIDTH - size),
+                                          m_random.bounded(GameConstants::GAME_AREA_HEIGHT - size));
+        if (isOpen(FixedRect::square(position, size))) break;
+    }
+    return position;
+}
+
+void StressRunner::buildWorld() {
+    m_engine.startHeadless();
+
+    // Terrain : garder la base et ses murs, remplacer le reste
+    m_engine.removeBlocksIf([](const auto& block) {
+        return block->getBox().top() < Fixed::fromPixels(GameConstants::GAME_AREA_HEIGHT - 96);
+    });
+
+    for (int y = 1; y < GameConstants::GRID_HEIGHT - 4; y++) {
+        for (int x = 0; x < GameConstants::GRID_WIDTH; x++) {
+            if (static_cast<int>(m_random.bounded(100)) >= m_config.blockDensity) continue;
+            const BlockType type = m_random.bounded(100) < 70 ? BlockType::BRICK : BlockType::STEEL;
+            m_engine.addBlock(std::make_unique<Block>(
+                FixedPoint::fromPixels(x * GameConstants::CELL_SIZE, y * GameConstants::CELL_SIZE), type));
+        }
+    }
+
+    // Aucune apparition « normale » : la population est gérée par replenish()
+    m_engine.stopWaves();
+    replenish();
+
+    for (int i = 0; i < m_config.powerUps; i++) {
+        const PowerUpType type = static_cast<PowerUpType>(m_random.bounded(3));
+        m_engine.addPowerUp(std::make_unique<PowerUp>(randomOpenPosition(24), type));
+    }
+}
+
+void StressRunner::replenish() {
+    // Le joueur et la base survivent : seule la charge nous intéresse
+    m_engine.reviveHeadless();
+
+    while (static_cast<int>(m_engine.getEnemies().size()) < m_config.enemies) {
+        m_engine.addEnemy(std::make_unique<Enemy>(randomOpenPosition(28)));
+    }
+
+    while (static_cast<int>(m_engine.getBullets().size()) < m_config.bullets) {
+        const Direction direction = static_cast<Direction>(m_random.bounded(4));
+        m_engine.addBullet(std::make_unique<Bullet>(randomOpenPosition(8),
+                                                    direction, m_random.bounded(2) == 0));
+    }
+
+    // Les zones sales ne sont consommées par aucun widget
+    m_engine.takeDirtyRegion();
+}
+
+StressReport StressRunner::run() {
+    m_engine.setParallelCollisions(m_config.parallelCollisions);
+    buildWorld();
+
+    Profiler& profiler = Profiler::instance();
+    profiler.setEnabled(true);
+    profiler.resetTotals();
+
+    StressReport report;
+    QElapsedTimer timer;
+
+    for (int tick = 0; tick < m_config.ticks; tick++) {
+        profiler.beginFrame();
+
+        timer.start();
+        m_engine.stepTick();
+        report.elapsedNs += timer.nsecsElapsed();
+
+        replenish();
+    }
+
+    report.ticks = m_config.ticks;
+    report.phases = profiler.getTotals();
+    report.peakMemoryKb = peakMemoryKb();
+    return report;
+}
+
+qint64 StressRunner::peakMemoryKb() {
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / 1024;   // Octets sous macOS
+#else
+    return usage.ru_maxrss;          // Kio sous Linux
+#endif
+#endif
+}
+
+int StressRunner::runFromCommandLine(const QCoreApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Scénario de charge sans interface");
+    parser.addHelpOption();
+
+    const QCommandLineOption stressOption("stress", "Lancer le scénario de charge.");
+    const QCommandLineOption enemiesOption("enemies", "Nombre d'ennemis.", "n", "100");
+    const QCommandLineOption bulletsOption("bullets", "Nombre de balles.", "n", "1000");
+    const QCommandLineOption powerUpsOption("powerups", "Nombre de power-ups.", "n", "20");
+    const QCommandLineOption densityOption("density", "Densité des blocs (%).", "pct", "20");
+    const QCommandLineOption ticksOption("ticks", "Nombre de ticks simulés.", "n", "6000");
+    const QCommandLineOption seedOption("seed", "Graine du monde synthétique.", "n", "1");
+    const QCommandLineOption serialOption("serial-collisions", "Détection des collisions sur un seul cœur.");
+    for (const auto& option : {stressOption, enemiesOption, bulletsOption, powerUpsOption,
+                               densityOption, ticksOption, seedOption, serialOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    StressConfig config;
+    config.enemies = qMax(0, parser.value(enemiesOption).toInt());
+    config.bullets = qMax(0, parser.value(bulletsOption).toInt());
+    config.powerUps = qMax(0, parser.value(powerUpsOption).toInt());
+    config.blockDensity = qBound(0, parser.value(densityOption).toInt(), 100);
+    config.ticks = qMax(1, parser.value(ticksOption).toInt());
+    config.seed = parser.value(seedOption).toUInt();
+    config.parallelCollisions = !parser.isSet(serialOption);
+
+    // Les traces de debug du moteur domineraient le temps mesuré
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    StressRunner runner(config);
+    const StressReport report = runner.run();
+
+    QTextStream out(stdout);
+    const double seconds = report.elapsedNs / 1.0e9;
+    out << "stress_config enemies=" << config.enemies << " bullets=" << config.bullets
+        << " powerups=" << config.powerUps << " density=" << config.blockDensity
+        << " ticks=" << config.ticks << " seed=" << config.seed
+        << " parallel_collisions=" << (config.parallelCollisions ? 1 : 0) << "\n";
+    out << "stress_result ticks_per_second=" << (seconds > 0 ? report.ticks / seconds : 0.0)
+        << " mean_tick_us=" << report.elapsedNs / 1000.0 / report.ticks
+        << " realtime_factor=" << (seconds > 0 ? report.ticks / seconds / GameConstants::SIMULATION_RATE : 0.0)
+        << " peak_memory_kb=" << report.peakMemoryKb << "\n";
+
+    const qint64 tickNs = report.phases.totalNs[static_cast<int>(ProfilePhase::TICK)];
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        if (report.phases.calls[phase] == 0) continue;
+        const qint64 totalNs = report.phases.totalNs[phase];
+        out << "stress_phase name=" << Profiler::phaseName(static_cast<ProfilePhase>(phase))
+            << " total_ms=" << totalNs / 1.0e6
+            << " mean_us=" << totalNs / 1000.0 / report.phases.calls[phase]
+            << " share=" << (tickNs > 0 ? 100.0 * totalNs / tickNs : 0.0) << "%\n";
+    }
+
+    return 0;
+}
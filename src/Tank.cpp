@@ -3,10 +3,10 @@
 #include <QPainter>
 #include <QtMath>
 
-Tank::Tank(const QPointF& position, EntityType type, const QColor& color, int speed)
-    : Entity(QRectF(position, QSizeF(TANK_SIZE, TANK_SIZE)), type, color)
+Tank::Tank(const FixedPoint& position, EntityType type, const QColor& color, int speed)
+    : Entity(FixedRect::square(position, TANK_SIZE), type, color)
     , m_direction(Direction::UP)
-    , m_speed(speed)
+    , m_speed(Fixed::fromPixels(speed))
     , m_health(GameConstants::MAX_PLAYER_HEALTH)
     , m_movingUp(false)
     , m_movingDown(false)
@@ -21,28 +21,28 @@ Tank::Tank(const QPointF& position, EntityType type, const QColor& color, int sp
 void Tank::update() {
     if (!m_active) return;
 
-    QPointF currentPos = m_rect.topLeft();
-    QPointF newPos = currentPos;
+    const FixedPoint currentPos = m_box.topLeft();
+    FixedPoint newPos = currentPos;
     bool attemptedMove = false;
 
     // Gestion du mouvement - un seul axe à la fois pour mouvement fluide
     if (m_movingUp) {
-        newPos.setY(currentPos.y() - m_speed);
+        newPos.y = currentPos.y - m_speed;
         m_direction = Direction::UP;
         attemptedMove = true;
     }
     else if (m_movingDown) {
-        newPos.setY(currentPos.y() + m_speed);
+        newPos.y = currentPos.y + m_speed;
         m_direction = Direction::DOWN;
         attemptedMove = true;
     }
     else if (m_movingLeft) {
-        newPos.setX(currentPos.x() - m_speed);
+        newPos.x = currentPos.x - m_speed;
         m_direction = Direction::LEFT;
         attemptedMove = true;
     }
     else if (m_movingRight) {
-        newPos.setX(currentPos.x() + m_speed);
+        newPos.x = currentPos.x + m_speed;
         m_direction = Direction::RIGHT;
         attemptedMove = true;
     }
@@ -50,14 +50,12 @@ void Tank::update() {
     // Appliquer les limites strictes SEULEMENT si on a tenté un mouvement
     if (attemptedMove) {
         // Clamp avec limites précises
-        newPos.setX(qMax(0.0, qMin(newPos.x(),
-                                   static_cast<double>(GameConstants::GAME_AREA_WIDTH - TANK_SIZE))));
-        newPos.setY(qMax(0.0, qMin(newPos.y(),
-                                   static_cast<double>(GameConstants::GAME_AREA_HEIGHT - TANK_SIZE))));
+        newPos.x = qBound(0, newPos.x, Fixed::fromPixels(GameConstants::GAME_AREA_WIDTH - TANK_SIZE));
+        newPos.y = qBound(0, newPos.y, Fixed::fromPixels(GameConstants::GAME_AREA_HEIGHT - TANK_SIZE));
 
         // Appliquer la nouvelle position seulement si elle a changé
         if (newPos != currentPos) {
-            m_rect.moveTo(newPos);
+            m_box.moveTo(newPos);
         }
     }
 
@@ -78,37 +76,52 @@ void Tank::update() {
 void Tank::render(QPainter& painter) {
     if (!m_active) return;
 
-    painter.save();
-
     // Dessiner le bouclier si actif
     if (m_shieldActive) {
-        painter.setPen(QPen(QColor(0, 191, 255, 128 + 127 * qSin(m_shieldTimer * 0.2)), 3));
-        painter.setBrush(Qt::NoBrush);
-        painter.drawEllipse(m_rect.center(), TANK_SIZE * 0.7, TANK_SIZE * 0.7);
+        renderShield(painter, getRect().center(), getShieldAlpha());
     }
 
+    renderBody(painter);
+}
+
+int Tank::getShieldAlpha() const {
+    return qBound(0, static_cast<int>(128 + 127 * qSin(m_shieldTimer * 0.2)), 255);
+}
+
+void Tank::renderShield(QPainter& painter, const QPointF& center, int alpha) {
+    painter.save();
+    painter.setPen(QPen(QColor(0, 191, 255, alpha), 3));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawEllipse(center, TANK_SIZE * 0.7, TANK_SIZE * 0.7);
+    painter.restore();
+}
+
+void Tank::renderBody(QPainter& painter) const {
+    const QRectF rect = getRect();
+    painter.save();
+
     // Dessiner le corps du tank
     painter.setBrush(m_color);
     painter.setPen(QPen(m_color.darker(130), 2));
-    painter.drawRect(m_rect);
+    painter.drawRect(rect);
 
     // Dessiner des détails sur le tank (chenilles)
     painter.setPen(QPen(m_color.darker(150), 1));
-    painter.drawLine(m_rect.left() + 4, m_rect.top(),
-                     m_rect.left() + 4, m_rect.bottom());
-    painter.drawLine(m_rect.right() - 4, m_rect.top(),
-                     m_rect.right() - 4, m_rect.bottom());
+    painter.drawLine(rect.left() + 4, rect.top(),
+                     rect.left() + 4, rect.bottom());
+    painter.drawLine(rect.right() - 4, rect.top(),
+                     rect.right() - 4, rect.bottom());
 
     // Dessiner le canon en fonction de la direction
     QRectF barrel;
-    QPointF center = m_rect.center();
+    QPointF center = rect.center();
 
     painter.setBrush(m_color.darker(120));
     painter.setPen(Qt::NoPen);
 
     switch (m_direction) {
     case Direction::UP:
-        barrel = QRectF(center.x() - BARREL_WIDTH/2, m_rect.top() - BARREL_LENGTH,
+        barrel = QRectF(center.x() - BARREL_WIDTH/2, rect.top() - BARREL_LENGTH,
                         BARREL_WIDTH, BARREL_LENGTH + TANK_SIZE/2);
         break;
     case Direction::DOWN:
@@ -116,7 +129,7 @@ void Tank::render(QPainter& painter) {
                         BARREL_WIDTH, BARREL_LENGTH + TANK_SIZE/2);
         break;
     case Direction::LEFT:
-        barrel = QRectF(m_rect.left() - BARREL_LENGTH, center.y() - BARREL_WIDTH/2,
+        barrel = QRectF(rect.left() - BARREL_LENGTH, center.y() - BARREL_WIDTH/2,
                         BARREL_LENGTH + TANK_SIZE/2, BARREL_WIDTH);
         break;
     case Direction::RIGHT:
@@ -134,6 +147,12 @@ void Tank::render(QPainter& painter) {
     painter.restore();
 }
 
+QRectF Tank::getRenderBounds() const {
+    // Le canon dépasse du corps, le bouclier aussi (rayon TANK_SIZE * 0.7)
+    const qreal margin = BARREL_LENGTH + 2;
+    return getRect().adjusted(-margin, -margin, margin, margin);
+}
+
 void Tank::setMoving(Direction dir, bool moving) {
     switch (dir) {
     case Direction::UP:
@@ -0,0 +1,273 @@
+#include "../include/TrainingEnv.hpp"
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QThread>
+#include <QDebug>
+#include <cstring>
+#include <new>
+
+namespace {
+constexpr int TERRAIN_CHANNELS = static_cast<int>(ObservationChannel::BASE) + 1;
+constexpr quint32 SHARED_MAGIC = 0x454B4E54;   // "TNKE" en petit-boutiste
+constexpr quint32 SHARED_VERSION = 1;
+constexpr qint32 CLOSE_ACTION = -2;
+constexpr int IDLE_SPINS = 1000;               // Avant de céder le processeur
+
+static_assert(std::atomic<quint32>::is_always_lock_free,
+              "les compteurs de la mémoire partagée doivent être sans verrou");
+
+quint32 sharedObservationOffset() {
+    // Observation alignée sur une ligne de cache
+    return (sizeof(TrainingSharedHeader) + 63) & ~quint32(63);
+}
+
+quint8* plane(quint8* observation, ObservationChannel channel) {
+    return observation + static_cast<int>(channel) * TrainingEnv::PLANE_SIZE;
+}
+
+// Case de la grille contenant une coordonnée fixe, bornée à la grille
+int cellOf(qint32 value, int cells) {
+    constexpr qint32 cellSize = Fixed::fromPixels(GameConstants::CELL_SIZE);
+    return value < 0 ? 0 : qMin(value / cellSize, cells - 1);
+}
+
+// Marquer les cases couvertes par la boîte
+void rasterize(quint8* target, const FixedRect& box) {
+    const int left = cellOf(box.left(), TrainingEnv::WIDTH);
+    const int top = cellOf(box.top(), TrainingEnv::HEIGHT);
+    const int right = cellOf(box.right() - 1, TrainingEnv::WIDTH);
+    const int bottom = cellOf(box.bottom() - 1, TrainingEnv::HEIGHT);
+
+    for (int y = top; y <= bottom; y++) {
+        std::memset(target + y * TrainingEnv::WIDTH + left, 1, right - left + 1);
+    }
+}
+}
+
+TrainingEnv::TrainingEnv(const TrainingConfig& config)
+    : m_config(config)
+    , m_engine(std::make_unique<GameEngine>())
+    , m_ticks(0)
+    , m_heldMove(InputAction::MOVE_UP)
+    , m_moving(false)
+    , m_terrainBlockCount(0)
+{
+    std::memset(m_terrain, 0, sizeof(m_terrain));
+    m_engine->setTuning(config.tuning);
+    m_engine->setPreloadNextLevel(false);   // Épisode terminé à la fin du niveau
+}
+
+TrainingEnv::~TrainingEnv() = default;
+
+void TrainingEnv::reset(quint32 seed, quint8* observation) {
+    // Le moteur est réutilisé d'un épisode à l'autre
+    m_engine->setSeed(seed);
+    m_engine->startHeadless();
+
+    m_ticks = 0;
+    m_moving = false;
+    m_terrainBlockCount = static_cast<size_t>(-1);
+
+    if (observation) {
+        writeObservation(observation);
+    }
+}
+
+StepResult TrainingEnv::step(TrainingAction action, quint8* observation) {
+    GameEngine& engine = *m_engine;
+    StepResult result;
+
+    if (engine.getState() == GameState::PLAYING) {
+        const int scoreBefore = engine.getScore();
+        const int healthBefore = engine.getPlayer()->getHealth();
+
+        setMoveAction(action);
+        if (action >= TrainingAction::FIRE) {
+            engine.submitInput(InputAction::SHOOT, true);
+        }
+
+        for (int i = 0; i < m_config.ticksPerStep && engine.getState() == GameState::PLAYING; i++) {
+            engine.stepTick();
+            m_ticks++;
+        }
+
+        result.reward = (engine.getScore() - scoreBefore) * REWARD_SCORE_SCALE;
+        const int healthAfter = engine.getPlayer()->isActive() ? engine.getPlayer()->getHealth() : 0;
+        if (healthAfter < healthBefore) {
+            result.reward += REWARD_HIT * (healthBefore - healthAfter);
+        }
+        if (engine.getState() == GameState::LEVEL_COMPLETE) {
+            result.reward += REWARD_WIN;
+        } else if (engine.getState() == GameState::GAME_OVER) {
+            result.reward += REWARD_LOSS;
+        }
+    }
+
+    result.done = engine.getState() != GameState::PLAYING || m_ticks >= m_config.maxTicks;
+    result.score = engine.getScore();
+    result.ticks = m_ticks;
+
+    if (observation) {
+        writeObservation(observation);
+    }
+    return result;
+}
+
+void TrainingEnv::setMoveAction(TrainingAction action) {
+    bool moving = true;
+    InputAction move = InputAction::MOVE_UP;
+    switch (action) {
+        case TrainingAction::UP:
+        case TrainingAction::UP_FIRE: move = InputAction::MOVE_UP; break;
+        case TrainingAction::DOWN:
+        case TrainingAction::DOWN_FIRE: move = InputAction::MOVE_DOWN; break;
+        case TrainingAction::LEFT:
+        case TrainingAction::LEFT_FIRE: move = InputAction::MOVE_LEFT; break;
+        case TrainingAction::RIGHT:
+        case TrainingAction::RIGHT_FIRE: move = InputAction::MOVE_RIGHT; break;
+        default: moving = false; break;
+    }
+
+    // Seuls les changements passent par la file d'entrées du moteur
+    if (m_moving && (!moving || move != m_heldMove)) {
+        m_engine->submitInput(m_heldMove, false);
+    }
+    if (moving && (!m_moving || move != m_heldMove)) {
+        m_engine->submitInput(move, true);
+    }
+    m_heldMove = move;
+    m_moving = moving;
+}
+
+void TrainingEnv::writeTerrain() {
+    std::memset(m_terrain, 0, sizeof(m_terrain));
+    for (const auto& block : m_engine->getBlocks()) {
+        if (!block->isActive()) continue;
+        const int channel = static_cast<int>(block->getBlockType());   // Même ordre que ObservationChannel
+        rasterize(m_terrain + channel * PLANE_SIZE, block->getBox());
+    }
+    m_terrainBlockCount = m_engine->getBlocks().size();
+}
+
+void TrainingEnv::writeObservation(quint8* out) {
+    const GameEngine& engine = *m_engine;
+
+    // Les blocs détruits sont retirés par cleanupInactive() : le nombre de
+    // blocs suffit à savoir si le terrain a changé
+    if (engine.getBlocks().size() != m_terrainBlockCount) {
+        writeTerrain();
+    }
+    std::memcpy(out, m_terrain, TERRAIN_CHANNELS * PLANE_SIZE);
+    std::memset(out + TERRAIN_CHANNELS * PLANE_SIZE, 0, (CHANNELS - TERRAIN_CHANNELS) * PLANE_SIZE);
+
+    for (const auto& enemy : engine.getEnemies()) {
+        if (enemy->isActive()) rasterize(plane(out, ObservationChannel::ENEMY), enemy->getBox());
+    }
+    for (const auto& bullet : engine.getBullets()) {
+        if (!bullet->isActive()) continue;
+        rasterize(plane(out, bullet->isFromPlayer() ? ObservationChannel::PLAYER_BULLET
+                                                    : ObservationChannel::ENEMY_BULLET),
+                  bullet->getBox());
+    }
+    for (const auto& powerUp : engine.getPowerUps()) {
+        if (powerUp->isActive()) rasterize(plane(out, ObservationChannel::POWERUP), powerUp->getBox());
+    }
+    if (engine.getPlayer() && engine.getPlayer()->isActive()) {
+        rasterize(plane(out, ObservationChannel::PLAYER), engine.getPlayer()->getBox());
+    }
+}
+
+bool TrainingEnv::createSharedMemory(const QString& key) {
+    m_shared.setKey(key);
+    if (!m_shared.create(sharedObservationOffset() + OBSERVATION_SIZE)) {
+        m_error = m_shared.errorString();
+        return false;
+    }
+
+    TrainingSharedHeader* header = new (m_shared.data()) TrainingSharedHeader();
+    header->magic = SHARED_MAGIC;
+    header->version = SHARED_VERSION;
+    header->channels = CHANNELS;
+    header->height = HEIGHT;
+    header->width = WIDTH;
+    header->observationOffset = sharedObservationOffset();
+    return true;
+}
+
+quint8* TrainingEnv::sharedObservation() {
+    return static_cast<quint8*>(m_shared.data()) + sharedObservationOffset();
+}
+
+int TrainingEnv::serve() {
+    TrainingSharedHeader* header = static_cast<TrainingSharedHeader*>(m_shared.data());
+    quint32 handled = header->responseSeq.load(std::memory_order_relaxed);
+    int idle = 0;
+
+    for (;;) {
+        const quint32 request = header->requestSeq.load(std::memory_order_acquire);
+        if (request == handled) {
+            // Attente active courte, puis on laisse la main
+            if (++idle > IDLE_SPINS) {
+                QThread::usleep(50);
+            }
+            continue;
+        }
+        idle = 0;
+
+        StepResult result;
+        if (header->action == CLOSE_ACTION) {
+            header->responseSeq.store(request, std::memory_order_release);
+            return 0;
+        } else if (header->action == RESET_ACTION) {
+            reset(header->seed, sharedObservation());
+        } else if (header->action >= 0 && header->action < static_cast<qint32>(TrainingAction::COUNT)) {
+            result = step(static_cast<TrainingAction>(header->action), sharedObservation());
+        } else {
+            result = step(TrainingAction::NOOP, sharedObservation());
+        }
+
+        header->reward = result.reward;
+        header->done = result.done ? 1 : 0;
+        header->score = result.score;
+        header->ticks = static_cast<quint32>(result.ticks);
+        handled = request;
+        header->responseSeq.store(request, std::memory_order_release);
+    }
+}
+
+int TrainingEnv::runFromCommandLine(const QCoreApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Environnement d'entraînement en mémoire partagée");
+    parser.addHelpOption();
+
+    const QCommandLineOption serverOption("train-server", "Clé du segment de mémoire partagée.", "clé");
+    const QCommandLineOption ticksPerStepOption("ticks-per-step", "Ticks simulés par action.", "n", "1");
+    const QCommandLineOption maxTicksOption("max-ticks", "Durée maximale d'un épisode en ticks.", "n",
+                                            QString::number(TrainingConfig().maxTicks));
+    for (const auto& option : {serverOption, ticksPerStepOption, maxTicksOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    TrainingConfig config;
+    config.ticksPerStep = qMax(1, parser.value(ticksPerStepOption).toInt());
+    config.maxTicks = qMax(1, parser.value(maxTicksOption).toInt());
+
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    TrainingEnv env(config);
+    const QString key = parser.value(serverOption);
+    if (!env.createSharedMemory(key)) {
+        qWarning() << "Mémoire partagée indisponible:" << key << "-" << env.errorString();
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << "train_server key=" << key << " channels=" << CHANNELS << " height=" << HEIGHT
+        << " width=" << WIDTH << " observation_offset=" << sharedObservationOffset()
+        << " actions=" << static_cast<int>(TrainingAction::COUNT) << "\n";
+    out.flush();
+
+    return env.serve();
+}
@@ -1,14 +1,80 @@
 #include <QApplication>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <cstring>
 #include "../include/MainWindow.hpp"
+#include "../include/StressRunner.hpp"
+#include "../include/BatchRunner.hpp"
+#include "../include/TrainingEnv.hpp"
+#include "../include/LockstepSession.hpp"
 
 int main(int argc, char *argv[]) {
+    // Modes sans interface : scénario de charge (StressRunner), parties
+    // simulées en lot (BatchRunner), environnement d'entraînement (TrainingEnv)
+    // et partie réseau entre deux bots (LockstepSession)
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--stress") == 0) {
+            QCoreApplication app(argc, argv);
+            return StressRunner::runFromCommandLine(app);
+        }
+        if (std::strcmp(argv[i], "--batch") == 0) {
+            QCoreApplication app(argc, argv);
+            return BatchRunner::runFromCommandLine(app);
+        }
+        if (std::strcmp(argv[i], "--train-server") == 0) {
+            QCoreApplication app(argc, argv);
+            return TrainingEnv::runFromCommandLine(app);
+        }
+        if (std::strcmp(argv[i], "--net-bot") == 0) {
+            QCoreApplication app(argc, argv);
+            return LockstepSession::runFromCommandLine(app);
+        }
+    }
+
     QApplication app(argc, argv);
     
     // Set application information
     QApplication::setApplicationName("Tank Battle Game");
     QApplication::setApplicationVersion("1.0.0");
     
+    // Niveaux compilés : --level a.lvl --level b.lvl, ou --campaign <dossier>
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Tank Battle");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption levelOption("level", "Niveau compilé (.lvl) à jouer, répétable.", "fichier");
+    const QCommandLineOption campaignOption("campaign", "Dossier de niveaux compilés, joués par ordre de nom.", "dossier");
+    parser.addOption(levelOption);
+    parser.addOption(campaignOption);
+    const QCommandLineOption recordOption("record", "Enregistrer les parties dans un replay (.rpl).", "fichier");
+    parser.addOption(recordOption);
+    // Partie à deux : --host <port> d'un côté, --connect <adresse:port> de l'autre
+    LockstepSession::addCommandLineOptions(parser);
+    parser.process(app);
+
+    QStringList campaign = parser.values(levelOption);
+    if (parser.isSet(campaignOption)) {
+        const QDir directory(parser.value(campaignOption));
+        for (const QString& name : directory.entryList(QStringList() << "*.lvl", QDir::Files, QDir::Name)) {
+            campaign << directory.filePath(name);
+        }
+    }
+
     MainWindow window;
+    if (!campaign.isEmpty()) {
+        window.setCampaign(campaign);
+    }
+    if (parser.isSet("host") || parser.isSet("connect")) {
+        LockstepConfig network;
+        if (!LockstepSession::configFromCommandLine(parser, network) || !window.startNetworkGame(network)) {
+            return 1;
+        }
+    }
+    // Après la session réseau éventuelle : elle seule sait quels ticks sont définitifs
+    if (parser.isSet(recordOption) && !window.startRecording(parser.value(recordOption))) {
+        return 1;
+    }
     window.show();
     
     return app.exec();
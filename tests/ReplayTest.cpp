@@ -0,0 +1,192 @@
+// Tests aller-retour du codec d'instantanés et du format de replay (Qt Test)
+//
+//   ctest --output-on-failure
+//   tank_replay_test -v2
+
+#include <QtTest>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <vector>
+#include "../include/StateSnapshot.hpp"
+#include "../include/ReplayFile.hpp"
+#include "../include/GameEngine.hpp"
+#include "../include/BotPlayer.hpp"
+
+namespace {
+constexpr quint32 SEED = 7;
+constexpr int TICKS = 600;
+constexpr int KEYFRAME_INTERVAL = 60;
+
+bool sameEntity(const EntityState& a, const EntityState& b) {
+    return a.id == b.id && a.type == b.type && a.direction == b.direction && a.health == b.health &&
+           a.flags == b.flags && a.x == b.x && a.y == b.y;
+}
+
+bool sameState(const WorldState& a, const WorldState& b) {
+    if (a.tick != b.tick || a.state != b.state || a.score != b.score ||
+        a.enemiesRemaining != b.enemiesRemaining || a.entities.size() != b.entities.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.entities.size(); i++) {
+        if (!sameEntity(a.entities[i], b.entities[i])) return false;
+    }
+    return true;
+}
+
+// Partie d'un BotPlayer, comme ReplayWriter::recordBotMatch : un état par tick
+std::vector<WorldState> botMatch(quint32 seed, int ticks) {
+    GameEngine engine;
+    engine.setSeed(seed);
+    engine.setPreloadNextLevel(false);
+    BotPlayer bot(seed);
+
+    std::vector<WorldState> states(ticks);
+    for (int tick = 0; tick < ticks; tick++) {
+        if (engine.getState() != GameState::PLAYING) {
+            engine.startHeadless();
+        }
+        bot.think(engine);
+        engine.stepTick();
+        states[tick].capture(engine);
+    }
+    return states;
+}
+}
+
+class ReplayTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void fullSnapshotRoundTrip();
+    void deltaRoundTrip();
+    void rejectsUnknownEntityChange();
+    void rejectsTruncatedDelta();
+    void seekMatchesStraightRead();
+    void seekOutOfRange();
+
+private:
+    std::vector<WorldState> m_states;
+};
+
+void ReplayTest::initTestCase() {
+    QLoggingCategory::setFilterRules("*.debug=false");
+    m_states = botMatch(SEED, TICKS);
+    QVERIFY(!m_states.front().entities.empty());
+}
+
+void ReplayTest::fullSnapshotRoundTrip() {
+    const WorldState empty;
+    QByteArray payload;
+    WorldState decoded;
+    for (const WorldState& state : m_states) {
+        SnapshotCodec::encodeDelta(empty, state, payload);
+        QVERIFY(SnapshotCodec::applyDelta(empty, payload.constData(), payload.size(), decoded));
+        QVERIFY2(sameState(decoded, state), qPrintable(QString("tick %1").arg(state.tick)));
+    }
+}
+
+void ReplayTest::deltaRoundTrip() {
+    // Chaîne de deltas depuis l'instantané complet du premier tick
+    const WorldState empty;
+    QByteArray payload;
+    WorldState current;
+    WorldState next;
+    SnapshotCodec::encodeDelta(empty, m_states.front(), payload);
+    QVERIFY(SnapshotCodec::applyDelta(empty, payload.constData(), payload.size(), current));
+
+    for (size_t i = 1; i < m_states.size(); i++) {
+        SnapshotCodec::encodeDelta(m_states[i - 1], m_states[i], payload);
+        QVERIFY(SnapshotCodec::applyDelta(current, payload.constData(), payload.size(), next));
+        QVERIFY2(sameState(next, m_states[i]), qPrintable(QString("tick %1").arg(m_states[i].tick)));
+        std::swap(current, next);
+    }
+}
+
+void ReplayTest::rejectsUnknownEntityChange() {
+    // Delta valide pour une entité connue, appliqué à une référence qui l'ignore
+    WorldState before;
+    EntityState entity;
+    entity.id = 5;
+    entity.type = 1;
+    entity.x = 256;
+    before.entities.push_back(entity);
+    WorldState after = before;
+    after.entities.front().x += 256;
+
+    QByteArray payload;
+    SnapshotCodec::encodeDelta(before, after, payload);
+    WorldState decoded;
+    QVERIFY(SnapshotCodec::applyDelta(before, payload.constData(), payload.size(), decoded));
+    QVERIFY(sameState(decoded, after));
+    QVERIFY(!SnapshotCodec::applyDelta(WorldState(), payload.constData(), payload.size(), decoded));
+}
+
+void ReplayTest::rejectsTruncatedDelta() {
+    QByteArray payload;
+    SnapshotCodec::encodeDelta(WorldState(), m_states.front(), payload);
+    WorldState decoded;
+    for (int size = 0; size < payload.size(); size++) {
+        QVERIFY2(!SnapshotCodec::applyDelta(WorldState(), payload.constData(), size, decoded),
+                 qPrintable(QString("%1 octets sur %2").arg(size).arg(payload.size())));
+    }
+}
+
+void ReplayTest::seekMatchesStraightRead() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("partie.rpl");
+
+    QString error;
+    ReplayWriter writer(KEYFRAME_INTERVAL);
+    QVERIFY2(writer.open(path, SEED, &error), qPrintable(error));
+    for (const WorldState& state : m_states) {
+        QVERIFY2(writer.append(state), qPrintable(writer.errorString()));
+    }
+    writer.close();
+
+    // Lecture continue depuis le début
+    ReplayReader reader;
+    QVERIFY2(reader.open(path, &error), qPrintable(error));
+    QCOMPARE(reader.tickCount(), static_cast<quint32>(TICKS));
+    QCOMPARE(reader.seed(), SEED);
+    for (const WorldState& state : m_states) {
+        QVERIFY(reader.readNext());
+        QVERIFY2(sameState(reader.state(), state), qPrintable(QString("tick %1").arg(state.tick)));
+    }
+    QVERIFY(!reader.readNext());
+
+    // Accès direct : sur une image clé, juste avant, juste après, au milieu
+    const quint32 middle = TICKS / 2 + KEYFRAME_INTERVAL / 3;
+    for (quint32 tick : {middle, 0u, quint32(KEYFRAME_INTERVAL - 1), quint32(KEYFRAME_INTERVAL),
+                         quint32(KEYFRAME_INTERVAL + 1), quint32(TICKS - 1)}) {
+        QVERIFY(reader.seek(tick));
+        QCOMPARE(reader.lastSeekDeltas(), static_cast<int>(tick % KEYFRAME_INTERVAL));
+        QVERIFY2(sameState(reader.state(), m_states[tick]), qPrintable(QString("tick %1").arg(tick)));
+    }
+
+    // Lecture continue reprise après un accès direct
+    QVERIFY(reader.seek(middle));
+    for (quint32 tick = middle + 1; tick < static_cast<quint32>(TICKS); tick++) {
+        QVERIFY(reader.readNext());
+        QVERIFY2(sameState(reader.state(), m_states[tick]), qPrintable(QString("tick %1").arg(tick)));
+    }
+}
+
+void ReplayTest::seekOutOfRange() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("court.rpl");
+
+    QString error;
+    QVERIFY2(ReplayWriter::recordBotMatch(path, SEED, KEYFRAME_INTERVAL / 2, KEYFRAME_INTERVAL, &error),
+             qPrintable(error));
+    ReplayReader reader;
+    QVERIFY2(reader.open(path, &error), qPrintable(error));
+    QVERIFY(reader.seek(KEYFRAME_INTERVAL / 2 - 1));
+    QVERIFY(!reader.seek(KEYFRAME_INTERVAL / 2));
+}
+
+QTEST_GUILESS_MAIN(ReplayTest)
+#include "ReplayTest.moc"
@@ -0,0 +1,78 @@
+// tank_levelc : compile une carte texte en niveau binaire (.lvl)
+//
+//   tank_levelc carte.txt niveau.lvl
+//
+// Cases : '.' vide, '#' brique, 'S' acier, '~' eau, 'T' arbres, 'H' base,
+// 'E' apparition ennemie, 'P' départ du joueur. Lignes « wave <ennemis>
+// <intervalle en ticks> <actifs max> » pour les vagues, « ; » pour commenter.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include "../include/LevelFile.hpp"
+#include "../include/LevelGenerator.hpp"
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("tank_levelc");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compilateur de niveaux Tank Battle");
+    parser.addHelpOption();
+    parser.addPositionalArgument("source", "Carte au format texte.");
+    parser.addPositionalArgument("destination", "Niveau binaire à écrire.");
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    QFile source(arguments.at(0));
+    if (!source.open(QIODevice::ReadOnly)) {
+        err << arguments.at(0) << ": " << source.errorString() << "\n";
+        return 1;
+    }
+
+    LevelLayout layout;
+    QString error;
+    if (!LevelFile::parseAscii(source.readAll(), layout, &error)) {
+        err << arguments.at(0) << ": " << error << "\n";
+        return 1;
+    }
+
+    // Même règle de connexité que les niveaux générés : chaque départ atteint la base
+    LevelSpec spec;
+    spec.width = layout.width;
+    spec.height = layout.height;
+    spec.sources = layout.spawns;
+    spec.sources.push_back(layout.playerSpawn);
+    for (int i = 0; i < layout.width * layout.height; i++) {
+        if (layout.tiles[i] == Tile::BASE) {
+            spec.target = QPoint(i % layout.width, i / layout.width);
+            break;
+        }
+    }
+    if (!LevelGenerator::isConnected(layout, spec)) {
+        err << arguments.at(0) << ": attention, un point de départ n'atteint pas la base\n";
+    }
+
+    QDir().mkpath(QFileInfo(arguments.at(1)).absolutePath());
+    QSaveFile destination(arguments.at(1));
+    if (!destination.open(QIODevice::WriteOnly)) {
+        err << arguments.at(1) << ": " << destination.errorString() << "\n";
+        return 1;
+    }
+    destination.write(LevelFile::serialize(layout));
+    if (!destination.commit()) {
+        err << arguments.at(1) << ": " << destination.errorString() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
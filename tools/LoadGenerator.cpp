@@ -0,0 +1,351 @@
+// tank_loadgen : clients simulés pour mesurer tank_server en local (Linux)
+//
+//   tank_loadgen --rooms 200 --clients-per-room 2 --duration 30 --threads 2
+//
+// Chaque client rejoint sa salle, envoie des entrées aléatoires et décode
+// tous les instantanés reçus, comme le ferait un vrai client. Le rapport
+// donne la bande passante par salle ; le serveur affiche de son côté le
+// coût d'une salle et le nombre de salles qu'un cœur peut tenir.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QThread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <memory>
+#include <vector>
+#include "../include/ServerProtocol.hpp"
+#include "../include/StateSnapshot.hpp"
+
+using namespace ServerProtocol;
+using namespace WireFormat;
+
+namespace {
+constexpr int MAX_EVENTS = 256;
+constexpr int READ_CHUNK = 16384;
+
+struct LoadConfig {
+    QByteArray host = "127.0.0.1";
+    quint16 port = DEFAULT_PORT;
+    int rooms = 100;
+    int clientsPerRoom = 2;
+    int seconds = 30;
+    int threads = 1;
+    int inputRate = 10;         // Changements d'entrée par seconde et par client
+    quint32 firstRoom = 1;
+};
+
+struct LoadReport {
+    int clients = 0;
+    int connected = 0;          // WELCOME reçu
+    int refused = 0;            // Connexion impossible ou salle pleine
+    quint64 snapshots = 0;
+    quint64 fullSnapshotBytes = 0;
+    int fullSnapshots = 0;
+    quint64 bytesReceived = 0;
+    quint64 bytesSent = 0;
+    quint64 decodeErrors = 0;
+
+    void merge(const LoadReport& other) {
+        clients += other.clients;
+        connected += other.connected;
+        refused += other.refused;
+        snapshots += other.snapshots;
+        fullSnapshotBytes += other.fullSnapshotBytes;
+        fullSnapshots += other.fullSnapshots;
+        bytesReceived += other.bytesReceived;
+        bytesSent += other.bytesSent;
+        decodeErrors += other.decodeErrors;
+    }
+};
+
+struct LoadClient {
+    int fd = -1;
+    quint32 roomId = 0;
+    bool joined = false;        // JOIN envoyé
+    bool welcomed = false;
+    qint64 nextInputNs = 0;
+    QByteArray inbox;
+    QByteArray outbox;
+    WorldState state;
+    WorldState next;
+};
+
+class LoadThread {
+public:
+    LoadThread(const LoadConfig& config, quint32 firstRoom, int rooms)
+        : m_config(config)
+        , m_firstRoom(firstRoom)
+        , m_rooms(rooms)
+        , m_random(firstRoom)
+    {
+    }
+
+    LoadReport run() {
+        m_epoll = epoll_create1(EPOLL_CLOEXEC);
+        for (int room = 0; room < m_rooms; room++) {
+            for (int i = 0; i < m_config.clientsPerRoom; i++) {
+                connectClient(m_firstRoom + room);
+            }
+        }
+
+        QElapsedTimer clock;
+        clock.start();
+        const qint64 endNs = m_config.seconds * 1000000000LL;
+        const qint64 inputPeriodNs = 1000000000LL / qMax(1, m_config.inputRate);
+        epoll_event events[MAX_EVENTS];
+
+        while (clock.nsecsElapsed() < endNs) {
+            const int count = epoll_wait(m_epoll, events, MAX_EVENTS, 5);
+            for (int i = 0; i < count; i++) {
+                LoadClient& client = *static_cast<LoadClient*>(events[i].data.ptr);
+                if (client.fd < 0) continue;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    disconnect(client);
+                    continue;
+                }
+                if (events[i].events & EPOLLOUT) onWritable(client);
+                if (client.fd >= 0 && (events[i].events & EPOLLIN)) onReadable(client);
+            }
+
+            const qint64 now = clock.nsecsElapsed();
+            for (auto& client : m_clients) {
+                if (client->fd < 0 || !client->welcomed || now < client->nextInputNs) continue;
+                client->nextInputNs = now + inputPeriodNs;
+                sendInput(*client);
+            }
+        }
+
+        for (auto& client : m_clients) {
+            if (client->fd >= 0) ::close(client->fd);
+        }
+        ::close(m_epoll);
+        return m_report;
+    }
+
+private:
+    void connectClient(quint32 roomId) {
+        auto client = std::make_unique<LoadClient>();
+        client->roomId = roomId;
+        m_report.clients++;
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(m_config.port);
+        inet_pton(AF_INET, m_config.host.constData(), &address.sin_addr);
+
+        client->fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (client->fd < 0 ||
+            (::connect(client->fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 && errno != EINPROGRESS)) {
+            if (client->fd >= 0) ::close(client->fd);
+            client->fd = -1;
+            m_report.refused++;
+            m_clients.push_back(std::move(client));
+            return;
+        }
+        const int enabled = 1;
+        setsockopt(client->fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+        // Connexion en cours : EPOLLOUT signale qu'elle est établie
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT;
+        event.data.ptr = client.get();
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, client->fd, &event);
+        m_clients.push_back(std::move(client));
+    }
+
+    void disconnect(LoadClient& client) {
+        if (!client.welcomed) m_report.refused++;
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, client.fd, nullptr);
+        ::close(client.fd);
+        client.fd = -1;
+    }
+
+    void onWritable(LoadClient& client) {
+        if (!client.joined) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(client.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0) {
+                disconnect(client);
+                return;
+            }
+
+            const int frame = beginFrame(client.outbox, MSG_JOIN);
+            appendU32(client.outbox, client.roomId);
+            appendU32(client.outbox, client.roomId * 2654435761u);
+            endFrame(client.outbox, frame);
+            client.joined = true;
+        }
+        flush(client);
+    }
+
+    void flush(LoadClient& client) {
+        while (!client.outbox.isEmpty()) {
+            const ssize_t sent = ::send(client.fd, client.outbox.constData(), client.outbox.size(), MSG_NOSIGNAL);
+            if (sent <= 0) break;
+            client.outbox.remove(0, static_cast<int>(sent));
+            m_report.bytesSent += static_cast<quint64>(sent);
+        }
+
+        // EPOLLOUT seulement tant qu'il reste des octets à envoyer
+        epoll_event event{};
+        event.events = client.outbox.isEmpty() ? EPOLLIN : EPOLLIN | EPOLLOUT;
+        event.data.ptr = &client;
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, client.fd, &event);
+    }
+
+    void sendInput(LoadClient& client) {
+        // Une direction au hasard (ou aucune), un tir une fois sur trois
+        const int move = m_random.bounded(5);
+        quint8 mask = move < 4 ? static_cast<quint8>(1 << move) : 0;
+        if (m_random.bounded(3) == 0) mask |= SHOOT_BIT;
+
+        const int frame = beginFrame(client.outbox, MSG_INPUT);
+        client.outbox.append(static_cast<char>(mask));
+        endFrame(client.outbox, frame);
+        flush(client);
+    }
+
+    void onReadable(LoadClient& client) {
+        char buffer[READ_CHUNK];
+        for (;;) {
+            const ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                client.inbox.append(buffer, static_cast<int>(received));
+                m_report.bytesReceived += static_cast<quint64>(received);
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) break;
+            disconnect(client);
+            return;
+        }
+
+        int offset = 0;
+        for (;;) {
+            const int length = frameLength(client.inbox.constData() + offset, client.inbox.size() - offset);
+            if (length <= 0) break;
+            handleMessage(client, client.inbox.constData() + offset + FRAME_HEADER_SIZE, length);
+            offset += FRAME_HEADER_SIZE + length;
+        }
+        client.inbox.remove(0, offset);
+    }
+
+    void handleMessage(LoadClient& client, const char* message, int length) {
+        switch (static_cast<quint8>(message[0])) {
+            case MSG_WELCOME:
+                client.welcomed = true;
+                m_report.connected++;
+                break;
+            case MSG_SNAPSHOT:
+                if (client.state.entities.empty()) {
+                    m_report.fullSnapshotBytes += static_cast<quint64>(length);
+                    m_report.fullSnapshots++;
+                }
+                if (SnapshotCodec::applyDelta(client.state, message + 1, length - 1, client.next)) {
+                    std::swap(client.state, client.next);
+                } else {
+                    m_report.decodeErrors++;
+                }
+                m_report.snapshots++;
+                break;
+            case MSG_ROOM_FULL:
+                client.welcomed = false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    LoadConfig m_config;
+    quint32 m_firstRoom;
+    int m_rooms;
+    int m_epoll = -1;
+    QRandomGenerator m_random;
+    std::vector<std::unique_ptr<LoadClient>> m_clients;
+    LoadReport m_report;
+};
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("tank_loadgen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Générateur de charge pour tank_server");
+    parser.addHelpOption();
+
+    const LoadConfig defaults;
+    const QCommandLineOption hostOption("host", "Adresse IPv4 du serveur.", "adresse", QString::fromLatin1(defaults.host));
+    const QCommandLineOption portOption("port", "Port TCP du serveur.", "port", QString::number(defaults.port));
+    const QCommandLineOption roomsOption("rooms", "Nombre de salles.", "n", QString::number(defaults.rooms));
+    const QCommandLineOption clientsOption("clients-per-room", "Clients par salle.", "n",
+                                           QString::number(defaults.clientsPerRoom));
+    const QCommandLineOption durationOption("duration", "Durée de la mesure en secondes.", "s",
+                                            QString::number(defaults.seconds));
+    const QCommandLineOption threadsOption("threads", "Threads clients.", "n", QString::number(defaults.threads));
+    const QCommandLineOption inputOption("input-rate", "Entrées envoyées par seconde et par client.", "hz",
+                                         QString::number(defaults.inputRate));
+    const QCommandLineOption firstRoomOption("first-room", "Numéro de la première salle.", "n",
+                                             QString::number(defaults.firstRoom));
+    for (const auto& option : {hostOption, portOption, roomsOption, clientsOption, durationOption,
+                               threadsOption, inputOption, firstRoomOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    LoadConfig config;
+    config.host = parser.value(hostOption).toLatin1();
+    config.port = static_cast<quint16>(parser.value(portOption).toUInt());
+    config.rooms = qMax(1, parser.value(roomsOption).toInt());
+    config.clientsPerRoom = qMax(1, parser.value(clientsOption).toInt());
+    config.seconds = qMax(1, parser.value(durationOption).toInt());
+    config.threads = qBound(1, parser.value(threadsOption).toInt(), config.rooms);
+    config.inputRate = qMax(1, parser.value(inputOption).toInt());
+    config.firstRoom = parser.value(firstRoomOption).toUInt();
+
+    // Salles réparties par blocs contigus entre les threads
+    std::vector<std::unique_ptr<LoadThread>> loads;
+    std::vector<LoadReport> reports(config.threads);
+    std::vector<std::unique_ptr<QThread>> threads;
+    int assigned = 0;
+    for (int i = 0; i < config.threads; i++) {
+        const int rooms = (config.rooms - assigned) / (config.threads - i);
+        loads.push_back(std::make_unique<LoadThread>(config, config.firstRoom + assigned, rooms));
+        assigned += rooms;
+
+        LoadThread* load = loads.back().get();
+        LoadReport* report = &reports[i];
+        threads.emplace_back(QThread::create([load, report]() { *report = load->run(); }));
+        threads.back()->start();
+    }
+
+    LoadReport total;
+    for (int i = 0; i < config.threads; i++) {
+        threads[i]->wait();
+        total.merge(reports[i]);
+    }
+
+    const double roomSeconds = static_cast<double>(config.rooms) * config.seconds;
+    QTextStream out(stdout);
+    out << "loadgen_result rooms=" << config.rooms << " clients=" << total.clients
+        << " connected=" << total.connected << " refused=" << total.refused
+        << " seconds=" << config.seconds << " snapshots=" << total.snapshots
+        << " snapshots_per_client_s=" << (total.connected > 0 ? total.snapshots / (static_cast<double>(total.connected) * config.seconds) : 0.0)
+        << " full_snapshot_bytes=" << (total.fullSnapshots > 0 ? total.fullSnapshotBytes / total.fullSnapshots : 0)
+        << " avg_snapshot_bytes=" << (total.snapshots > 0 ? total.bytesReceived / total.snapshots : 0)
+        << " bytes_in_per_room_s=" << total.bytesReceived / roomSeconds
+        << " bytes_out_per_room_s=" << total.bytesSent / roomSeconds
+        << " decode_errors=" << total.decodeErrors << "\n";
+    out.flush();
+
+    return total.decodeErrors == 0 ? 0 : 1;
+}
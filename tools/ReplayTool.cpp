@@ -0,0 +1,126 @@
+// tank_replay : enregistrement et lecture des replays (.rpl)
+//
+//   tank_replay record partie.rpl --seed 7 --ticks 36000
+//   tank_replay info partie.rpl
+//   tank_replay seek partie.rpl --tick 20000
+//   tank_replay bench partie.rpl --seeks 1000
+//
+// « seek » et « bench » lisent aussi un fichier en cours d'écriture.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+#include "../include/ReplayFile.hpp"
+#include "../include/Constants.hpp"
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("tank_replay");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays Tank Battle : image clé + deltas, accès direct à un tick");
+    parser.addHelpOption();
+    parser.addPositionalArgument("commande", "record, info, seek ou bench.");
+    parser.addPositionalArgument("fichier", "Fichier de replay.");
+
+    const QCommandLineOption seedOption("seed", "Graine de la partie enregistrée.", "graine", "1");
+    const QCommandLineOption ticksOption("ticks", "Ticks à enregistrer.", "n",
+                                         QString::number(10 * 60 * GameConstants::SIMULATION_RATE));
+    const QCommandLineOption intervalOption("keyframe-interval", "Ticks entre deux images clés.", "n",
+                                            QString::number(ReplayFormat::DEFAULT_KEYFRAME_INTERVAL));
+    const QCommandLineOption tickOption("tick", "Tick à atteindre.", "n", "0");
+    const QCommandLineOption seeksOption("seeks", "Accès aléatoires mesurés.", "n", "1000");
+    for (const auto& option : {seedOption, ticksOption, intervalOption, tickOption, seeksOption}) {
+        parser.addOption(option);
+    }
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2) {
+        parser.showHelp(1);
+    }
+    const QString command = arguments.at(0);
+    const QString path = arguments.at(1);
+
+    QLoggingCategory::setFilterRules("*.debug=false");
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    QString error;
+
+    if (command == "record") {
+        QElapsedTimer timer;
+        timer.start();
+        const int ticks = qMax(1, parser.value(ticksOption).toInt());
+        if (!ReplayWriter::recordBotMatch(path, parser.value(seedOption).toUInt(), ticks,
+                                          parser.value(intervalOption).toInt(), &error)) {
+            err << path << ": " << error << "\n";
+            return 1;
+        }
+        out << "replay_record ticks=" << ticks << " elapsed_ms=" << timer.elapsed() << "\n";
+        return 0;
+    }
+
+    ReplayReader reader;
+    if (!reader.open(path, &error)) {
+        err << path << ": " << error << "\n";
+        return 1;
+    }
+
+    if (command == "info") {
+        out << "replay_info ticks=" << reader.tickCount() << " keyframe_interval=" << reader.keyframeInterval()
+            << " tick_rate=" << reader.tickRate() << " seed=" << reader.seed()
+            << " bytes=" << reader.dataSize()
+            << " bytes_per_tick=" << (reader.tickCount() > 0 ? static_cast<double>(reader.dataSize()) / reader.tickCount() : 0.0)
+            << "\n";
+        return 0;
+    }
+
+    if (command == "seek") {
+        const quint32 tick = parser.value(tickOption).toUInt();
+        QElapsedTimer timer;
+        timer.start();
+        if (!reader.seek(tick)) {
+            err << path << ": tick " << tick << " indisponible (" << reader.tickCount() << " ticks)\n";
+            return 1;
+        }
+        const WorldState& state = reader.state();
+        out << "replay_seek tick=" << tick << " engine_tick=" << state.tick << " entities=" << state.entities.size()
+            << " score=" << state.score << " deltas=" << reader.lastSeekDeltas()
+            << " elapsed_us=" << timer.nsecsElapsed() / 1000 << "\n";
+        return 0;
+    }
+
+    if (command == "bench") {
+        if (reader.tickCount() == 0) {
+            err << path << ": replay vide\n";
+            return 1;
+        }
+        const int seeks = qMax(1, parser.value(seeksOption).toInt());
+        QRandomGenerator random(1);
+        std::vector<qint64> durations;
+        durations.reserve(seeks);
+        for (int i = 0; i < seeks; i++) {
+            const quint32 tick = random.bounded(reader.tickCount());
+            QElapsedTimer timer;
+            timer.start();
+            if (!reader.seek(tick)) {
+                err << path << ": échec au tick " << tick << "\n";
+                return 1;
+            }
+            durations.push_back(timer.nsecsElapsed());
+        }
+        std::sort(durations.begin(), durations.end());
+        out << "replay_bench seeks=" << seeks << " ticks=" << reader.tickCount()
+            << " median_us=" << durations[durations.size() / 2] / 1000.0
+            << " p99_us=" << durations[durations.size() * 99 / 100] / 1000.0
+            << " max_us=" << durations.back() / 1000.0 << "\n";
+        return 0;
+    }
+
+    parser.showHelp(1);
+}